@@ -0,0 +1,179 @@
+/**
+ * ChunkedVector.cc
+ *
+ * Implementation file for ChunkedVector template class.
+ * Contains the definitions of all member functions.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#include <new>
+#include <cstdint>
+#include <algorithm>
+
+// Move constructor implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+ChunkedVector<T, ChunkSize, Alignment>::ChunkedVector(ChunkedVector&& other) {
+    m_stlChunks.swap(other.m_stlChunks);
+
+    m_nSize = other.m_nSize;
+    other.m_nSize = 0;
+}
+
+// Copy constructor implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+ChunkedVector<T, ChunkSize, Alignment>::ChunkedVector(const ChunkedVector& other) : m_nSize(0) {
+    m_stlChunks.resize(other.m_stlChunks.size(), nullptr);
+
+    try {
+        ParallelForChunks(m_stlChunks.size(), [&](size_t chunk) {
+            m_stlChunks[chunk] = allocateChunk();
+            std::copy(other.m_stlChunks[chunk], other.m_stlChunks[chunk] + ChunkSize, m_stlChunks[chunk]);
+        });
+    } catch (...) {
+        clear();
+        throw;
+    }
+
+    m_nSize = other.m_nSize;
+}
+
+// Assignment operator implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+ChunkedVector<T, ChunkSize, Alignment>& ChunkedVector<T, ChunkSize, Alignment>::operator=(ChunkedVector other) {
+    m_stlChunks.swap(other.m_stlChunks);
+    std::swap(m_nSize, other.m_nSize);
+    return *this;
+}
+
+// Destructor implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+ChunkedVector<T, ChunkSize, Alignment>::~ChunkedVector() {
+    clear();
+}
+
+// push_back implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+void ChunkedVector<T, ChunkSize, Alignment>::push_back(const T& value) {
+    if (m_nSize == m_stlChunks.size() * ChunkSize) {
+        T* chunk = allocateChunk();
+        try {
+            m_stlChunks.push_back(chunk);
+        } catch (...) {
+            freeChunk(chunk);
+            throw;
+        }
+    }
+
+    (*this)[m_nSize] = value;
+    m_nSize++;
+}
+
+// resize implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+void ChunkedVector<T, ChunkSize, Alignment>::resize(size_t count) {
+    size_t oldChunkCount = m_stlChunks.size();
+    size_t newChunkCount = (count + ChunkSize - 1) / ChunkSize;
+
+    // Elements past the old size in the last kept chunk may hold stale values.
+    size_t keptEnd = std::min(oldChunkCount * ChunkSize, count);
+    for (size_t i = m_nSize; i < keptEnd; i++) {
+        (*this)[i] = T();
+    }
+
+    for (size_t chunk = newChunkCount; chunk < oldChunkCount; chunk++) {
+        freeChunk(m_stlChunks[chunk]);
+    }
+
+    m_stlChunks.resize(newChunkCount, nullptr);
+
+    if (newChunkCount > oldChunkCount) {
+        // Every worker allocates the new chunks it owns under the final partition.
+        try {
+            ParallelForChunks(newChunkCount, [&](size_t chunk) {
+                if (chunk >= oldChunkCount) {
+                    m_stlChunks[chunk] = allocateChunk();
+                }
+            });
+        } catch (...) {
+            // Drop the chunks allocated before the failure; the old contents are kept.
+            for (size_t chunk = oldChunkCount; chunk < newChunkCount; chunk++) {
+                freeChunk(m_stlChunks[chunk]);
+            }
+            m_stlChunks.resize(oldChunkCount);
+            throw;
+        }
+    }
+
+    m_nSize = count;
+}
+
+// clear implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+void ChunkedVector<T, ChunkSize, Alignment>::clear() {
+    for (size_t chunk = 0; chunk < m_stlChunks.size(); chunk++) {
+        freeChunk(m_stlChunks[chunk]);
+    }
+
+    m_stlChunks.clear();
+    m_nSize = 0;
+}
+
+// ChunkLength implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+size_t ChunkedVector<T, ChunkSize, Alignment>::ChunkLength(size_t chunk) const {
+    if (chunk + 1 < m_stlChunks.size()) {
+        return ChunkSize;
+    }
+
+    return m_nSize - chunk * ChunkSize;
+}
+
+// ParallelForChunks implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+template <typename Function>
+void ChunkedVector<T, ChunkSize, Alignment>::ParallelForChunks(size_t chunkCount, Function function,
+                                                               unsigned threadCount) {
+    WorkerPool::ParallelFor(chunkCount, function, threadCount);
+}
+
+// Private: allocateChunk implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+T* ChunkedVector<T, ChunkSize, Alignment>::allocateChunk() {
+    // Over-allocate and keep the raw pointer just in front of the aligned block.
+    char* raw = static_cast<char*>(::operator new(ChunkSize * sizeof(T) + Alignment + sizeof(void*)));
+    uintptr_t address = reinterpret_cast<uintptr_t>(raw + sizeof(void*));
+    address = (address + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1);
+
+    T* chunk = reinterpret_cast<T*>(address);
+    reinterpret_cast<void**>(chunk)[-1] = raw;
+
+    size_t constructed = 0;
+    try {
+        for (; constructed < ChunkSize; constructed++) {
+            new (chunk + constructed) T();
+        }
+    } catch (...) {
+        while (constructed > 0) {
+            chunk[--constructed].~T();
+        }
+        ::operator delete(raw);
+        throw;
+    }
+
+    return chunk;
+}
+
+// Private: freeChunk implementation
+template <typename T, size_t ChunkSize, size_t Alignment>
+void ChunkedVector<T, ChunkSize, Alignment>::freeChunk(T* chunk) {
+    if (chunk == nullptr) {
+        return;
+    }
+
+    for (size_t i = 0; i < ChunkSize; i++) {
+        chunk[i].~T();
+    }
+
+    ::operator delete(reinterpret_cast<void**>(chunk)[-1]);
+}
@@ -0,0 +1,277 @@
+/**
+ * ChunkedVector.h
+ *
+ * Header file for ChunkedVector template class, a segmented storage backend
+ * for LazyVector made of fixed-size, aligned chunks.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#ifndef CHUNKEDVECTOR_H
+#define CHUNKEDVECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+
+#include "WorkerPool.h"
+
+/**
+ * ChunkedVector class template.
+ *
+ * A vector-like container that stores its elements in fixed-size chunks
+ * instead of one contiguous block. Growing the container only allocates a new
+ * chunk, so existing elements are never copied or moved.
+ *
+ * Chunks are statically partitioned across the CPU-pinned threads of the
+ * WorkerPool (see ParallelForChunks). resize() allocates new chunks under the
+ * same partition that later evaluates them, so each of those chunks is first
+ * touched on the CPU that processes it, which keeps its pages local on NUMA
+ * hosts. Chunks added by push_back are allocated on the calling thread and get
+ * no such placement.
+ *
+ * Template Parameters:
+ *   T         - The data type of elements stored in the container (must be default constructible)
+ *   ChunkSize - The number of elements per chunk (must be a power of two)
+ *   Alignment - The byte alignment of every chunk (must be a power of two)
+ */
+template <typename T, size_t ChunkSize = 65536, size_t Alignment = 64>
+class ChunkedVector {
+public:
+    static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                  "ChunkSize must be a power of two");
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two");
+
+    /**
+     * BasicIterator class template.
+     *
+     * Random access iterator over the elements in index order. Moving it is
+     * index arithmetic; the chunk is only resolved on dereference.
+     *
+     * Template Parameters:
+     *   Value     - The element type seen through the iterator (T or const T)
+     *   Container - The container type (ChunkedVector or const ChunkedVector)
+     */
+    template <typename Value, typename Container>
+    class BasicIterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        BasicIterator() : m_pContainer(nullptr), m_nIndex(0) {}
+        BasicIterator(Container* pContainer, size_t index) : m_pContainer(pContainer), m_nIndex(index) {}
+
+        /// Converts an iterator into a const_iterator.
+        template <typename OtherValue, typename OtherContainer>
+        BasicIterator(const BasicIterator<OtherValue, OtherContainer>& other)
+            : m_pContainer(other.m_pContainer), m_nIndex(other.m_nIndex) {}
+
+        reference operator*() const { return (*m_pContainer)[m_nIndex]; }
+        pointer operator->() const { return &(*m_pContainer)[m_nIndex]; }
+        reference operator[](difference_type offset) const { return (*m_pContainer)[m_nIndex + offset]; }
+
+        BasicIterator& operator++() { m_nIndex++; return *this; }
+        BasicIterator& operator--() { m_nIndex--; return *this; }
+        BasicIterator operator++(int) { BasicIterator previous(*this); m_nIndex++; return previous; }
+        BasicIterator operator--(int) { BasicIterator previous(*this); m_nIndex--; return previous; }
+        BasicIterator& operator+=(difference_type offset) { m_nIndex += offset; return *this; }
+        BasicIterator& operator-=(difference_type offset) { m_nIndex -= offset; return *this; }
+        BasicIterator operator+(difference_type offset) const { return BasicIterator(m_pContainer, m_nIndex + offset); }
+        BasicIterator operator-(difference_type offset) const { return BasicIterator(m_pContainer, m_nIndex - offset); }
+        friend BasicIterator operator+(difference_type offset, const BasicIterator& it) { return it + offset; }
+        difference_type operator-(const BasicIterator& other) const {
+            return static_cast<difference_type>(m_nIndex) - static_cast<difference_type>(other.m_nIndex);
+        }
+
+        bool operator==(const BasicIterator& other) const { return m_nIndex == other.m_nIndex; }
+        bool operator!=(const BasicIterator& other) const { return m_nIndex != other.m_nIndex; }
+        bool operator<(const BasicIterator& other) const { return m_nIndex < other.m_nIndex; }
+        bool operator>(const BasicIterator& other) const { return m_nIndex > other.m_nIndex; }
+        bool operator<=(const BasicIterator& other) const { return m_nIndex <= other.m_nIndex; }
+        bool operator>=(const BasicIterator& other) const { return m_nIndex >= other.m_nIndex; }
+
+    private:
+        Container* m_pContainer;    ///< The iterated container
+        size_t m_nIndex;            ///< The index of the current element
+
+        template <typename OtherValue, typename OtherContainer> friend class BasicIterator;
+    };
+
+    typedef T value_type;
+    typedef BasicIterator<T, ChunkedVector> iterator;
+    typedef BasicIterator<const T, const ChunkedVector> const_iterator;
+
+    /**
+     * Default constructor.
+     * Initializes an empty ChunkedVector without allocating any chunk.
+     */
+    ChunkedVector() : m_nSize(0) {}
+
+    /**
+     * Move constructor.
+     * Takes over the chunks of another ChunkedVector without copying elements.
+     *
+     * Parameters:
+     *   other - The ChunkedVector to move from (will be left empty after construction)
+     */
+    ChunkedVector(ChunkedVector&& other);
+
+    /**
+     * Copy constructor.
+     * Creates a deep copy of another ChunkedVector. Chunks are allocated and
+     * copied in parallel, under the same partition as resize.
+     *
+     * Parameters:
+     *   other - The ChunkedVector to copy from
+     */
+    ChunkedVector(const ChunkedVector& other);
+
+    /**
+     * Assignment operator overload.
+     *
+     * Replaces the contents with a copy (or the moved contents) of another
+     * ChunkedVector.
+     *
+     * Parameters:
+     *   other - The ChunkedVector to assign from
+     *
+     * Returns:
+     *   A reference to this ChunkedVector after assignment
+     */
+    ChunkedVector& operator=(ChunkedVector other);
+
+    /**
+     * Destructor.
+     * Destroys all elements and releases every chunk.
+     */
+    ~ChunkedVector();
+
+    /**
+     * Adds a value to the end of the container.
+     *
+     * Allocates a new chunk when the last one is full; existing elements
+     * are never relocated.
+     *
+     * Parameters:
+     *   value - The value to add
+     */
+    void push_back(const T& value);
+
+    /**
+     * Resizes the container to hold count elements.
+     *
+     * Missing chunks are allocated and value-initialized in parallel through
+     * ParallelForChunks (see the class comment for placement). Surplus chunks
+     * are released.
+     * If an allocation fails, the container keeps its previous size.
+     *
+     * Parameters:
+     *   count - The new number of elements
+     */
+    void resize(size_t count);
+
+    /**
+     * Removes all elements and releases every chunk.
+     */
+    void clear();
+
+    /**
+     * Returns whether the container holds no elements.
+     */
+    bool empty() const { return m_nSize == 0; }
+
+    /**
+     * Returns the number of elements in the container.
+     */
+    size_t size() const { return m_nSize; }
+
+    /**
+     * Subscript operator overload for element access.
+     *
+     * Parameters:
+     *   index - The zero-based index of the element
+     *
+     * Returns:
+     *   A reference to the element at the specified index
+     */
+    T& operator[](size_t index) { return m_stlChunks[index / ChunkSize][index % ChunkSize]; }
+    const T& operator[](size_t index) const { return m_stlChunks[index / ChunkSize][index % ChunkSize]; }
+
+    /**
+     * Iterator access over the elements, in index order.
+     */
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_nSize); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_nSize); }
+
+    /**
+     * Returns the number of allocated chunks.
+     */
+    size_t ChunkCount() const { return m_stlChunks.size(); }
+
+    /**
+     * Returns a pointer to the first element of a chunk.
+     * The pointer is aligned to Alignment bytes.
+     *
+     * Parameters:
+     *   chunk - The zero-based index of the chunk
+     */
+    T* ChunkData(size_t chunk) { return m_stlChunks[chunk]; }
+    const T* ChunkData(size_t chunk) const { return m_stlChunks[chunk]; }
+
+    /**
+     * Returns the number of used elements in a chunk.
+     * Every chunk but the last one is full.
+     *
+     * Parameters:
+     *   chunk - The zero-based index of the chunk
+     */
+    size_t ChunkLength(size_t chunk) const;
+
+    /**
+     * Runs a function over chunks [0, chunkCount) on the WorkerPool.
+     *
+     * The chunks are partitioned as by WorkerPool::ParallelFor, which also
+     * describes how exceptions are reported.
+     *
+     * Parameters:
+     *   chunkCount  - The number of chunks to process
+     *   function    - Callable invoked as function(chunk) for every chunk
+     *   threadCount - The number of worker threads (0 selects WorkerPool::DefaultWorkerCount)
+     */
+    template <typename Function>
+    static void ParallelForChunks(size_t chunkCount, Function function, unsigned threadCount = 0);
+
+private:
+    /**
+     * Allocates one aligned chunk and value-initializes its elements.
+     *
+     * Returns:
+     *   A pointer to the first element of the chunk
+     */
+    static T* allocateChunk();
+
+    /**
+     * Destroys the elements of a chunk and releases its memory.
+     *
+     * Parameters:
+     *   chunk - A pointer previously returned by allocateChunk, or nullptr
+     */
+    static void freeChunk(T* chunk);
+
+private:
+    std::vector<T*> m_stlChunks;    ///< Aligned pointers to the chunks, in element order
+    size_t m_nSize;                 ///< The number of elements in use
+};
+
+// Include the implementation file
+#include "ChunkedVector.cc"
+
+#endif // CHUNKEDVECTOR_H
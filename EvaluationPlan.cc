@@ -0,0 +1,460 @@
+/**
+ * EvaluationPlan.cc
+ *
+ * Implementation file for PlanExpression and EvaluationPlan template classes.
+ * Contains the definitions of all member functions and operator overloads.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#include <algorithm>
+
+// PlanExpression: Placeholder implementation
+template <typename T>
+PlanExpression<T> PlanExpression<T>::Placeholder(size_t index) {
+    std::shared_ptr<Node> pNode(new Node());
+    pNode->eKind = PlaceholderNode;
+    pNode->eOperator = Operator::Unknown;
+    pNode->nPlaceholder = index;
+    pNode->value = T();
+
+    PlanExpression<T> expression;
+    expression.m_pNode = pNode;
+    return expression;
+}
+
+// PlanExpression: Constant implementation
+template <typename T>
+PlanExpression<T> PlanExpression<T>::Constant(T value) {
+    std::shared_ptr<Node> pNode(new Node());
+    pNode->eKind = ConstantNode;
+    pNode->eOperator = Operator::Unknown;
+    pNode->nPlaceholder = 0;
+    pNode->value = value;
+
+    PlanExpression<T> expression;
+    expression.m_pNode = pNode;
+    return expression;
+}
+
+// PlanExpression: Private: combine implementation
+template <typename T>
+PlanExpression<T> PlanExpression<T>::combine(Operator eOperator, const PlanExpression<T>& lhs,
+                                             const PlanExpression<T>& rhs, const std::shared_ptr<const Node>& pMask) {
+    if (!lhs.m_pNode || !rhs.m_pNode) {
+        throw std::invalid_argument("Expression operands should not be empty.");
+    }
+
+    std::shared_ptr<Node> pNode(new Node());
+    pNode->eKind = OperationNode;
+    pNode->eOperator = eOperator;
+    pNode->nPlaceholder = 0;
+    pNode->value = T();
+    pNode->pLeft = lhs.m_pNode;
+    pNode->pRight = rhs.m_pNode;
+    pNode->pMask = pMask;
+
+    PlanExpression<T> expression;
+    expression.m_pNode = pNode;
+    return expression;
+}
+
+// PlanExpression: Addition operator implementation
+template <typename T>
+PlanExpression<T> operator+(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::Add, lhs, rhs);
+}
+
+// PlanExpression: Subtraction operator implementation
+template <typename T>
+PlanExpression<T> operator-(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::Subtract, lhs, rhs);
+}
+
+// PlanExpression: Multiplication operator implementation
+template <typename T>
+PlanExpression<T> operator*(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::Multiply, lhs, rhs);
+}
+
+// PlanExpression: Division operator implementation
+template <typename T>
+PlanExpression<T> operator/(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::Divide, lhs, rhs);
+}
+
+// PlanExpression: Comparison operators implementation
+template <typename T>
+PlanExpression<T> operator>(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::Greater, lhs, rhs);
+}
+
+template <typename T>
+PlanExpression<T> operator>=(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::GreaterEqual, lhs, rhs);
+}
+
+template <typename T>
+PlanExpression<T> operator<(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::Less, lhs, rhs);
+}
+
+template <typename T>
+PlanExpression<T> operator<=(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::LessEqual, lhs, rhs);
+}
+
+template <typename T>
+PlanExpression<T> operator==(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::Equal, lhs, rhs);
+}
+
+template <typename T>
+PlanExpression<T> operator!=(const PlanExpression<T>& lhs, const PlanExpression<T>& rhs) {
+    return PlanExpression<T>::combine(Operator::NotEqual, lhs, rhs);
+}
+
+// PlanExpression: Select implementation
+template <typename T>
+PlanExpression<T> Select(const PlanExpression<T>& mask, const PlanExpression<T>& ifTrue,
+                         const PlanExpression<T>& ifFalse) {
+    if (!mask.m_pNode) {
+        throw std::invalid_argument("Expression operands should not be empty.");
+    }
+
+    return PlanExpression<T>::combine(Operator::MaskedSelect, ifTrue, ifFalse, mask.m_pNode);
+}
+
+// Constructor implementation
+template <typename T, typename Storage>
+EvaluationPlan<T, Storage>::EvaluationPlan(const PlanExpression<T>& expression, size_t blockSize)
+    : m_nInputCount(0), m_nScratchCount(0), m_nBlockSize(blockSize) {
+    if (!expression.m_pNode) {
+        throw std::invalid_argument("Expression to be compiled should not be empty.");
+    }
+
+    if (blockSize == 0) {
+        throw std::invalid_argument("Block size should be greater than zero.");
+    }
+
+    std::map<const Node*, size_t> uses;
+    std::map<const Node*, size_t> constants;
+    std::map<const Node*, size_t> registers;
+    std::vector<size_t> freeScratch;
+
+    countUses(expression.m_pNode.get(), uses, constants);
+    if (m_nInputCount == 0) {
+        throw std::invalid_argument("Expression to be compiled should use at least one placeholder.");
+    }
+
+    // Constant registers directly follow the inputs.
+    for (typename std::map<const Node*, size_t>::iterator it = constants.begin(); it != constants.end(); ++it) {
+        registers[it->first] = m_nInputCount + it->second;
+    }
+
+    size_t result = compileNode(expression.m_pNode.get(), true, uses, registers, freeScratch);
+
+    // A bare placeholder or constant still has to be copied into the output.
+    if (m_stlProgram.empty()) {
+        Instruction instruction = { &EvaluationPlan<T, Storage>::copyKernel, 0, result, result, result };
+        m_stlProgram.push_back(instruction);
+    }
+
+    // The output register follows the scratch registers, whose count is only known now.
+    size_t output = m_nInputCount + m_stlConstants.size() + m_nScratchCount;
+    m_stlProgram.back().nTarget = output;
+}
+
+// Execute implementation
+template <typename T, typename Storage>
+LazyVector<T, Storage> EvaluationPlan<T, Storage>::Execute(const std::vector<LazyVector<T, Storage>*>& inputs) const {
+    if (inputs.size() < m_nInputCount) {
+        throw std::invalid_argument("Every placeholder of the plan should be bound to a vector.");
+    }
+
+    for (size_t i = 0; i < m_nInputCount; i++) {
+        if (inputs[i] == nullptr) {
+            throw std::invalid_argument("Every placeholder of the plan should be bound to a vector.");
+        }
+
+        if (inputs[i]->size() != inputs[0]->size()) {
+            throw std::invalid_argument("Vectors to be evaluated should have same size.");
+        }
+    }
+
+    LazyVector<T, Storage> result(inputs[0]->size());
+    Storage& output = result.m_stlVector;
+
+    StorageTraits<Storage>::ForEachChunk(StorageTraits<Storage>::ChunkCount(output), [&](size_t chunk) {
+        this->executeChunk(inputs, output, chunk);
+    });
+
+    return result;
+}
+
+// ExecuteBatch implementation
+template <typename T, typename Storage>
+std::vector<LazyVector<T, Storage> > EvaluationPlan<T, Storage>::ExecuteBatch(
+    const std::vector<std::vector<LazyVector<T, Storage>*> >& inputSets) const {
+    std::vector<LazyVector<T, Storage> > results;
+    results.reserve(inputSets.size());
+
+    for (size_t i = 0; i < inputSets.size(); i++) {
+        results.push_back(Execute(inputSets[i]));
+    }
+
+    return results;
+}
+
+// Private: countUses implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::countUses(const Node* pNode, std::map<const Node*, size_t>& uses,
+                                           std::map<const Node*, size_t>& constants) {
+    if (pNode->eKind == PlanExpression<T>::PlaceholderNode) {
+        m_nInputCount = std::max(m_nInputCount, pNode->nPlaceholder + 1);
+        return;
+    }
+
+    if (pNode->eKind == PlanExpression<T>::ConstantNode) {
+        if (constants.find(pNode) == constants.end()) {
+            constants[pNode] = m_stlConstants.size();
+            m_stlConstants.push_back(pNode->value);
+        }
+        return;
+    }
+
+    // Shared subexpressions are only walked on their first use.
+    if (uses[pNode]++ == 0) {
+        countUses(pNode->pLeft.get(), uses, constants);
+        countUses(pNode->pRight.get(), uses, constants);
+        if (pNode->pMask) {
+            countUses(pNode->pMask.get(), uses, constants);
+        }
+    }
+}
+
+// Private: compileNode implementation
+template <typename T, typename Storage>
+size_t EvaluationPlan<T, Storage>::compileNode(const Node* pNode, bool isRoot, std::map<const Node*, size_t>& uses,
+                                               std::map<const Node*, size_t>& registers,
+                                               std::vector<size_t>& freeScratch) {
+    if (pNode->eKind == PlanExpression<T>::PlaceholderNode) {
+        return pNode->nPlaceholder;
+    }
+
+    typename std::map<const Node*, size_t>::iterator compiled = registers.find(pNode);
+    if (compiled != registers.end()) {
+        return compiled->second;
+    }
+
+    size_t left = compileNode(pNode->pLeft.get(), false, uses, registers, freeScratch);
+    size_t right = compileNode(pNode->pRight.get(), false, uses, registers, freeScratch);
+    size_t mask = left;
+    if (pNode->pMask) {
+        mask = compileNode(pNode->pMask.get(), false, uses, registers, freeScratch);
+    }
+
+    // Element-wise kernels may write over their own operands, so those are released first.
+    releaseOperand(pNode->pLeft.get(), uses, registers, freeScratch);
+    releaseOperand(pNode->pRight.get(), uses, registers, freeScratch);
+    if (pNode->pMask) {
+        releaseOperand(pNode->pMask.get(), uses, registers, freeScratch);
+    }
+
+    size_t target = 0;
+    if (!isRoot) {
+        if (freeScratch.empty()) {
+            target = m_nInputCount + m_stlConstants.size() + m_nScratchCount++;
+        } else {
+            target = freeScratch.back();
+            freeScratch.pop_back();
+        }
+    }
+
+    Instruction instruction = { resolveKernel(pNode->eOperator), target, left, right, mask };
+    m_stlProgram.push_back(instruction);
+
+    registers[pNode] = target;
+    return target;
+}
+
+// Private: releaseOperand implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::releaseOperand(const Node* pNode, std::map<const Node*, size_t>& uses,
+                                                std::map<const Node*, size_t>& registers,
+                                                std::vector<size_t>& freeScratch) {
+    if (pNode->eKind != PlanExpression<T>::OperationNode) {
+        return;
+    }
+
+    if (--uses[pNode] == 0) {
+        freeScratch.push_back(registers[pNode]);
+    }
+}
+
+// Private: resolveKernel implementation
+template <typename T, typename Storage>
+typename EvaluationPlan<T, Storage>::Kernel EvaluationPlan<T, Storage>::resolveKernel(Operator eOperator) {
+    switch (eOperator) {
+    case Operator::Add :
+        return &EvaluationPlan<T, Storage>::addKernel;
+    case Operator::Subtract :
+        return &EvaluationPlan<T, Storage>::subtractKernel;
+    case Operator::Multiply :
+        return &EvaluationPlan<T, Storage>::multiplyKernel;
+    case Operator::Divide :
+        return &EvaluationPlan<T, Storage>::divideKernel;
+    case Operator::Greater :
+        return &EvaluationPlan<T, Storage>::greaterKernel;
+    case Operator::GreaterEqual :
+        return &EvaluationPlan<T, Storage>::greaterEqualKernel;
+    case Operator::Less :
+        return &EvaluationPlan<T, Storage>::lessKernel;
+    case Operator::LessEqual :
+        return &EvaluationPlan<T, Storage>::lessEqualKernel;
+    case Operator::Equal :
+        return &EvaluationPlan<T, Storage>::equalKernel;
+    case Operator::NotEqual :
+        return &EvaluationPlan<T, Storage>::notEqualKernel;
+    case Operator::MaskedSelect :
+        return &EvaluationPlan<T, Storage>::selectKernel;
+    default :
+        throw std::invalid_argument("Invalid Operation");
+    }
+}
+
+// Private: executeChunk implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::executeChunk(const std::vector<LazyVector<T, Storage>*>& inputs, Storage& output,
+                                              size_t chunk) const {
+    size_t length = StorageTraits<Storage>::ChunkLength(output, chunk);
+    T* outputData = StorageTraits<Storage>::ChunkData(output, chunk);
+
+    size_t constantCount = m_stlConstants.size();
+    size_t bufferCount = constantCount + m_nScratchCount;
+    std::vector<T> buffers(bufferCount * m_nBlockSize);
+    std::vector<T*> registers(m_nInputCount + bufferCount + 1);
+
+    for (size_t i = 0; i < bufferCount; i++) {
+        registers[m_nInputCount + i] = &buffers[i * m_nBlockSize];
+    }
+
+    // Constants are broadcast once per chunk and then read like any other operand.
+    for (size_t i = 0; i < constantCount; i++) {
+        std::fill(registers[m_nInputCount + i], registers[m_nInputCount + i] + m_nBlockSize, m_stlConstants[i]);
+    }
+
+    for (size_t offset = 0; offset < length; offset += m_nBlockSize) {
+        size_t blockLength = std::min(m_nBlockSize, length - offset);
+
+        // Input registers are only ever read by the kernels.
+        for (size_t i = 0; i < m_nInputCount; i++) {
+            const T* inputData = StorageTraits<Storage>::ChunkData(inputs[i]->m_stlVector, chunk);
+            registers[i] = const_cast<T*>(inputData + offset);
+        }
+        registers[m_nInputCount + bufferCount] = outputData + offset;
+
+        for (size_t i = 0; i < m_stlProgram.size(); i++) {
+            const Instruction& instruction = m_stlProgram[i];
+            instruction.pfnKernel(registers[instruction.nTarget], registers[instruction.nLeft],
+                                  registers[instruction.nRight], registers[instruction.nMask], blockLength);
+        }
+    }
+}
+
+// Private: addKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::addKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = left[i] + right[i];
+    }
+}
+
+// Private: subtractKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::subtractKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = left[i] - right[i];
+    }
+}
+
+// Private: multiplyKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::multiplyKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = left[i] * right[i];
+    }
+}
+
+// Private: divideKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::divideKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = left[i] / right[i];
+    }
+}
+
+// Private: greaterKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::greaterKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = static_cast<T>(left[i] > right[i]);
+    }
+}
+
+// Private: greaterEqualKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::greaterEqualKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = static_cast<T>(left[i] >= right[i]);
+    }
+}
+
+// Private: lessKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::lessKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = static_cast<T>(left[i] < right[i]);
+    }
+}
+
+// Private: lessEqualKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::lessEqualKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = static_cast<T>(left[i] <= right[i]);
+    }
+}
+
+// Private: equalKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::equalKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = static_cast<T>(left[i] == right[i]);
+    }
+}
+
+// Private: notEqualKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::notEqualKernel(T* target, const T* left, const T* right, const T*, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        target[i] = static_cast<T>(left[i] != right[i]);
+    }
+}
+
+// Private: selectKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::selectKernel(T* target, const T* left, const T* right, const T* mask, size_t length) {
+    // Same branch-free blend as LazyVector::MaskedAssign.
+    for (size_t i = 0; i < length; i++) {
+        T ifTrue = left[i];
+        T ifFalse = right[i];
+        target[i] = mask[i] != T(0) ? ifTrue : ifFalse;
+    }
+}
+
+// Private: copyKernel implementation
+template <typename T, typename Storage>
+void EvaluationPlan<T, Storage>::copyKernel(T* target, const T* left, const T*, const T*, size_t length) {
+    std::copy(left, left + length, target);
+}
@@ -0,0 +1,282 @@
+/**
+ * EvaluationPlan.h
+ *
+ * Header file for PlanExpression and EvaluationPlan template classes, which
+ * compile a symbolic LazyVector expression once and evaluate it against many
+ * input sets.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#ifndef EVALUATIONPLAN_H
+#define EVALUATIONPLAN_H
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include "LazyVector.h"
+
+/**
+ * PlanExpression class template.
+ *
+ * A symbolic expression whose leaves are placeholders for input vectors
+ * (or constants) instead of concrete LazyVectors. Expressions are combined
+ * with the usual arithmetic and comparison operators and with Select, and
+ * later compiled into an EvaluationPlan. Subexpressions used more than once
+ * are shared and evaluated only once.
+ *
+ * Comparisons produce masks: expressions holding 1 where the comparison
+ * holds and 0 elsewhere. Masks can be combined arithmetically (mask * mask
+ * is a logical and) and drive Select.
+ *
+ * Template Parameters:
+ *   T - The data type of the vector elements
+ */
+template <typename T>
+class PlanExpression {
+public:
+    /**
+     * Creates a placeholder for an input vector.
+     *
+     * Parameters:
+     *   index - The zero-based position of the vector in the input set
+     *
+     * Returns:
+     *   An expression standing for the input vector at that position
+     */
+    static PlanExpression<T> Placeholder(size_t index);
+
+    /**
+     * Creates a constant, broadcast to every element.
+     *
+     * Parameters:
+     *   value - The value of every element
+     *
+     * Returns:
+     *   An expression standing for a vector filled with value
+     */
+    static PlanExpression<T> Constant(T value);
+
+    /**
+     * Arithmetic operator overloads.
+     *
+     * Build a new expression applying the operation element-wise to both
+     * operands. Nothing is evaluated.
+     */
+    template <typename U> friend PlanExpression<U> operator+(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator-(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator*(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator/(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+
+    /**
+     * Comparison operator overloads.
+     *
+     * Build a new mask expression comparing both operands element-wise.
+     * Nothing is evaluated.
+     */
+    template <typename U> friend PlanExpression<U> operator>(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator>=(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator<(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator<=(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator==(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+    template <typename U> friend PlanExpression<U> operator!=(const PlanExpression<U>& lhs, const PlanExpression<U>& rhs);
+
+    /**
+     * Builds an expression choosing, element-wise, ifTrue where mask is
+     * non-zero and ifFalse elsewhere.
+     *
+     * Both alternatives are evaluated for every element and blended without
+     * branches, so they must be safe to compute everywhere (beware of integer
+     * division by zero in the discarded alternative).
+     */
+    template <typename U> friend PlanExpression<U> Select(const PlanExpression<U>& mask, const PlanExpression<U>& ifTrue,
+                                                          const PlanExpression<U>& ifFalse);
+
+private:
+    /**
+     * Kinds of expression tree nodes.
+     */
+    enum NodeKind {
+        PlaceholderNode,    ///< An input vector
+        ConstantNode,       ///< A broadcast constant
+        OperationNode       ///< An operation over other nodes
+    };
+
+    /**
+     * Node of the expression tree.
+     * Only operation nodes have operands; only Select uses pMask.
+     */
+    struct Node {
+        NodeKind eKind;                     ///< The kind of this node
+        Operator eOperator;                 ///< The operation of an operation node
+        size_t nPlaceholder;                ///< The input index of a placeholder node
+        T value;                            ///< The value of a constant node
+        std::shared_ptr<const Node> pLeft;  ///< The left operand (or the value chosen where the mask is set)
+        std::shared_ptr<const Node> pRight; ///< The right operand (or the value chosen elsewhere)
+        std::shared_ptr<const Node> pMask;  ///< The mask of a Select node
+    };
+
+    /**
+     * Builds an operation node over two expressions (and the mask of a Select).
+     */
+    static PlanExpression<T> combine(Operator eOperator, const PlanExpression<T>& lhs, const PlanExpression<T>& rhs,
+                                     const std::shared_ptr<const Node>& pMask = std::shared_ptr<const Node>());
+
+    std::shared_ptr<const Node> m_pNode;    ///< The root node of the expression
+
+    template <typename U, typename S> friend class EvaluationPlan;
+};
+
+/**
+ * EvaluationPlan class template.
+ *
+ * A compiled form of a PlanExpression. Construction resolves the kernel of
+ * every operation, orders the operations and assigns their intermediates to
+ * a small set of reusable scratch buffers. Execution then evaluates the whole
+ * expression block by block (fused), so intermediates stay in cache and no
+ * full-size temporary vector is ever created. Blocks never cross storage
+ * chunks, and chunks are evaluated as described by StorageTraits.
+ *
+ * Comparisons and Select compile to branch-free kernels, so masked
+ * expressions fuse like arithmetic ones.
+ *
+ * A plan holds no input data and can be executed any number of times,
+ * concurrently if desired.
+ *
+ * Template Parameters:
+ *   T       - The data type of the vector elements
+ *   Storage - The storage of the LazyVectors the plan reads and produces
+ */
+template <typename T, typename Storage = std::vector<T> >
+class EvaluationPlan {
+public:
+    /**
+     * Constructor.
+     * Compiles an expression into a plan.
+     *
+     * Parameters:
+     *   expression - The expression to compile
+     *   blockSize  - The number of elements evaluated per fused block
+     *
+     * Throws:
+     *   std::invalid_argument - If the expression is empty or blockSize is zero
+     */
+    explicit EvaluationPlan(const PlanExpression<T>& expression, size_t blockSize = 1024);
+
+    /**
+     * Evaluates the plan against one input set.
+     *
+     * Parameters:
+     *   inputs - The vectors bound to the placeholders, by placeholder index
+     *
+     * Returns:
+     *   A LazyVector holding the result
+     *
+     * Throws:
+     *   std::invalid_argument - If inputs are missing or have different sizes
+     */
+    LazyVector<T, Storage> Execute(const std::vector<LazyVector<T, Storage>*>& inputs) const;
+
+    /**
+     * Evaluates the plan against several input sets.
+     *
+     * Parameters:
+     *   inputSets - The input sets, each laid out as for Execute
+     *
+     * Returns:
+     *   The results, in the order of inputSets
+     *
+     * Throws:
+     *   std::invalid_argument - If any input set is invalid
+     */
+    std::vector<LazyVector<T, Storage> > ExecuteBatch(
+        const std::vector<std::vector<LazyVector<T, Storage>*> >& inputSets) const;
+
+    /**
+     * Returns the number of inputs the plan expects.
+     */
+    size_t InputCount() const { return m_nInputCount; }
+
+private:
+    /// Signature of an element-wise kernel: target[i] = left[i] op right[i], mask is only read by Select.
+    typedef void (*Kernel)(T* target, const T* left, const T* right, const T* mask, size_t length);
+
+    /**
+     * One step of the compiled program, operating on registers.
+     * Registers [0, m_nInputCount) are the inputs, the following ones hold
+     * the constants, then come m_nScratchCount scratch buffers and the last
+     * one is the output.
+     */
+    struct Instruction {
+        Kernel pfnKernel;   ///< The pre-resolved kernel
+        size_t nTarget;     ///< The register written
+        size_t nLeft;       ///< The register of the left operand
+        size_t nRight;      ///< The register of the right operand
+        size_t nMask;       ///< The register of the mask operand of Select
+    };
+
+    typedef typename PlanExpression<T>::Node Node;
+
+    /**
+     * Counts how often each operation node is used as an operand, finds the
+     * number of inputs and collects the constants.
+     */
+    void countUses(const Node* pNode, std::map<const Node*, size_t>& uses, std::map<const Node*, size_t>& constants);
+
+    /**
+     * Emits the instructions of a node after those of its operands.
+     * A scratch register is released as soon as its last user is emitted.
+     *
+     * Returns:
+     *   The register holding the value of the node
+     */
+    size_t compileNode(const Node* pNode, bool isRoot, std::map<const Node*, size_t>& uses,
+                       std::map<const Node*, size_t>& registers, std::vector<size_t>& freeScratch);
+
+    /**
+     * Decrements the use count of an operand and releases its scratch
+     * register once it has no users left.
+     */
+    void releaseOperand(const Node* pNode, std::map<const Node*, size_t>& uses,
+                        std::map<const Node*, size_t>& registers, std::vector<size_t>& freeScratch);
+
+    /**
+     * Returns the kernel implementing an operator.
+     *
+     * Throws:
+     *   std::invalid_argument - If the operator is invalid/unknown
+     */
+    static Kernel resolveKernel(Operator eOperator);
+
+    /**
+     * Runs the program over one storage chunk of an input set.
+     */
+    void executeChunk(const std::vector<LazyVector<T, Storage>*>& inputs, Storage& output, size_t chunk) const;
+
+    static void addKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void subtractKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void multiplyKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void divideKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void greaterKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void greaterEqualKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void lessKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void lessEqualKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void equalKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void notEqualKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void selectKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+    static void copyKernel(T* target, const T* left, const T* right, const T* mask, size_t length);
+
+private:
+    std::vector<Instruction> m_stlProgram;  ///< The compiled instructions, in execution order
+    std::vector<T> m_stlConstants;          ///< The values of the constant registers
+    size_t m_nInputCount;                   ///< The number of input registers
+    size_t m_nScratchCount;                 ///< The number of scratch registers
+    size_t m_nBlockSize;                    ///< The number of elements per fused block
+};
+
+// Include the implementation file
+#include "EvaluationPlan.cc"
+
+#endif // EVALUATIONPLAN_H
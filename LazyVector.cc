@@ -8,24 +8,32 @@
  */
 
 // Move constructor implementation
-template <typename T>
-LazyVector<T>::LazyVector(LazyVector<T>&& other) {
-    m_stlVector = other.m_stlVector;
+template <typename T, typename Storage>
+LazyVector<T, Storage>::LazyVector(LazyVector<T, Storage>&& other) {
+    m_stlVector = std::move(other.m_stlVector);
     other.m_stlVector.clear();
 
     m_eOperator = other.m_eOperator;
     other.m_eOperator = Operator::Unknown;
 
-    m_stlOtherVector = other.m_stlOtherVector;
+    m_stlOtherVector = std::move(other.m_stlOtherVector);
     other.m_stlOtherVector.clear();
+
+    m_fnScan = std::move(other.m_fnScan);
+    other.m_fnScan = nullptr;
+
+    m_nWindow = other.m_nWindow;
+    other.m_nWindow = 0;
 }
 
 // Copy constructor implementation
-template <typename T>
-LazyVector<T>::LazyVector(const LazyVector<T>& other) {
+template <typename T, typename Storage>
+LazyVector<T, Storage>::LazyVector(const LazyVector<T, Storage>& other) {
     this->m_stlVector = other.m_stlVector;
     this->m_eOperator = other.m_eOperator;
     this->m_stlOtherVector = other.m_stlOtherVector;
+    this->m_fnScan = other.m_fnScan;
+    this->m_nWindow = other.m_nWindow;
 
     if (this->m_eOperator != Operator::Unknown) {
         this->performOperation();
@@ -33,9 +41,9 @@ LazyVector<T>::LazyVector(const LazyVector<T>& other) {
 }
 
 // PushValue implementation
-template <typename T>
-void LazyVector<T>::PushValue(T value) {
-    if (!m_stlOtherVector.empty()) {
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::PushValue(T value) {
+    if (m_eOperator != Operator::Unknown) {
         throw std::invalid_argument(
             "Invalid Operation: Vector should be operated on before new element can be added.");
     }
@@ -44,8 +52,8 @@ void LazyVector<T>::PushValue(T value) {
 }
 
 // Addition operator implementation
-template <typename T>
-LazyVector<T> LazyVector<T>::operator+(LazyVector<T>& otherVector) {
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator+(LazyVector<T, Storage>& otherVector) {
     if (m_stlVector.size() != otherVector.size()) {
         throw std::invalid_argument("Vectors to be added should have same size.");
     }
@@ -56,8 +64,8 @@ LazyVector<T> LazyVector<T>::operator+(LazyVector<T>& otherVector) {
 }
 
 // Subtraction operator implementation
-template <typename T>
-LazyVector<T> LazyVector<T>::operator-(LazyVector<T>& otherVector) {
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator-(LazyVector<T, Storage>& otherVector) {
     if (m_stlVector.size() != otherVector.size()) {
         throw std::invalid_argument("Vectors to be subtracted should have same size.");
     }
@@ -68,8 +76,8 @@ LazyVector<T> LazyVector<T>::operator-(LazyVector<T>& otherVector) {
 }
 
 // Multiplication operator implementation
-template <typename T>
-LazyVector<T> LazyVector<T>::operator*(LazyVector<T>& otherVector) {
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator*(LazyVector<T, Storage>& otherVector) {
     if (m_stlVector.size() != otherVector.size()) {
         throw std::invalid_argument("Vectors to be multiplied should have same size.");
     }
@@ -80,8 +88,8 @@ LazyVector<T> LazyVector<T>::operator*(LazyVector<T>& otherVector) {
 }
 
 // Division operator implementation
-template <typename T>
-LazyVector<T> LazyVector<T>::operator/(LazyVector<T>& otherVector) {
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator/(LazyVector<T, Storage>& otherVector) {
     if (m_stlVector.size() != otherVector.size()) {
         throw std::invalid_argument("Vectors to be divided should have same size.");
     }
@@ -91,9 +99,118 @@ LazyVector<T> LazyVector<T>::operator/(LazyVector<T>& otherVector) {
     return *this;
 }
 
+// Comparison operators implementation
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator>(LazyVector<T, Storage>& otherVector) {
+    return storeComparison(Operator::Greater, otherVector);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator>=(LazyVector<T, Storage>& otherVector) {
+    return storeComparison(Operator::GreaterEqual, otherVector);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator<(LazyVector<T, Storage>& otherVector) {
+    return storeComparison(Operator::Less, otherVector);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator<=(LazyVector<T, Storage>& otherVector) {
+    return storeComparison(Operator::LessEqual, otherVector);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator==(LazyVector<T, Storage>& otherVector) {
+    return storeComparison(Operator::Equal, otherVector);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::operator!=(LazyVector<T, Storage>& otherVector) {
+    return storeComparison(Operator::NotEqual, otherVector);
+}
+
+// MaskedAssign implementation
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::MaskedAssign(LazyVector<T, Storage>& mask, LazyVector<T, Storage>& values) {
+    if (m_stlVector.size() != mask.size() || m_stlVector.size() != values.size()) {
+        throw std::invalid_argument("Vectors to be assigned should have same size.");
+    }
+
+    StorageTraits<Storage>::ForEachChunk(StorageTraits<Storage>::ChunkCount(m_stlVector), [&](size_t chunk) {
+        T* lhs = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        const T* selector = StorageTraits<Storage>::ChunkData(mask.m_stlVector, chunk);
+        const T* rhs = StorageTraits<Storage>::ChunkData(values.m_stlVector, chunk);
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        // Both values are loaded unconditionally so the compiler emits a blend instead of a branch.
+        for (size_t i = 0; i < length; i++) {
+            T replacement = rhs[i];
+            T current = lhs[i];
+            lhs[i] = selector[i] != T(0) ? replacement : current;
+        }
+    });
+
+    // A pending operation stored by an earlier operator would be replayed on the new contents.
+    m_eOperator = Operator::Unknown;
+    m_stlOtherVector.clear();
+    m_fnScan = nullptr;
+    m_nWindow = 0;
+}
+
+// CumSum implementation
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::CumSum() {
+    this->m_eOperator = Operator::CumulativeSum;
+    this->m_stlOtherVector.clear();
+    return *this;
+}
+
+// CumProd implementation
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::CumProd() {
+    this->m_eOperator = Operator::CumulativeProduct;
+    this->m_stlOtherVector.clear();
+    return *this;
+}
+
+// Scan implementation
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::Scan(std::function<T(T, T)> op) {
+    if (!op) {
+        throw std::invalid_argument("Scan operation should not be empty.");
+    }
+
+    this->m_eOperator = Operator::PrefixScan;
+    this->m_fnScan = op;
+    this->m_stlOtherVector.clear();
+    return *this;
+}
+
+// Rolling window implementations
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::RollingSum(size_t window) {
+    return storeWindow(Operator::WindowSum, window);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::RollingMean(size_t window) {
+    return storeWindow(Operator::WindowMean, window);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::RollingMin(size_t window) {
+    return storeWindow(Operator::WindowMin, window);
+}
+
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::RollingMax(size_t window) {
+    return storeWindow(Operator::WindowMax, window);
+}
+
 // Assignment operator implementation
-template <typename T>
-LazyVector<T>& LazyVector<T>::operator=(LazyVector<T>& otherVector) {
+template <typename T, typename Storage>
+LazyVector<T, Storage>& LazyVector<T, Storage>::operator=(LazyVector<T, Storage>& otherVector) {
     if (otherVector.m_eOperator == Operator::Unknown) {
         return *this;
     }
@@ -101,24 +218,28 @@ LazyVector<T>& LazyVector<T>::operator=(LazyVector<T>& otherVector) {
     this->m_stlVector = otherVector.m_stlVector;
     this->m_eOperator = otherVector.m_eOperator;
     this->m_stlOtherVector = otherVector.m_stlOtherVector;
+    this->m_fnScan = otherVector.m_fnScan;
+    this->m_nWindow = otherVector.m_nWindow;
 
     this->performOperation();
 
     otherVector.m_eOperator = Operator::Unknown;
     otherVector.m_stlOtherVector.clear();
+    otherVector.m_fnScan = nullptr;
+    otherVector.m_nWindow = 0;
 
     return *this;
 }
 
 // size implementation
-template <typename T>
-size_t LazyVector<T>::size() {
+template <typename T, typename Storage>
+size_t LazyVector<T, Storage>::size() {
     return m_stlVector.size();
 }
 
 // PrintVector implementation
-template <typename T>
-void LazyVector<T>::PrintVector() {
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::PrintVector() {
     for (int i = 0; i < m_stlVector.size(); i++) {
         std::cout << m_stlVector[i] << " ";
     }
@@ -127,52 +248,526 @@ void LazyVector<T>::PrintVector() {
 }
 
 // GetVector implementation
-template <typename T>
-std::vector<T> LazyVector<T>::GetVector() {
-    return m_stlVector;
+template <typename T, typename Storage>
+std::vector<T> LazyVector<T, Storage>::GetVector() {
+    std::vector<T> stlVector;
+    stlVector.reserve(m_stlVector.size());
+
+    for (size_t chunk = 0; chunk < StorageTraits<Storage>::ChunkCount(m_stlVector); chunk++) {
+        const T* data = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        stlVector.insert(stlVector.end(), data, data + StorageTraits<Storage>::ChunkLength(m_stlVector, chunk));
+    }
+
+    return stlVector;
+}
+
+// data implementation
+template <typename T, typename Storage>
+T* LazyVector<T, Storage>::data() {
+    return m_stlVector.data();
+}
+
+// View implementation
+template <typename T, typename Storage>
+VectorView<T> LazyVector<T, Storage>::View() {
+    return VectorView<T>(m_stlVector.data(), m_stlVector.size());
+}
+
+// ChunkCount implementation
+template <typename T, typename Storage>
+size_t LazyVector<T, Storage>::ChunkCount() {
+    return StorageTraits<Storage>::ChunkCount(m_stlVector);
+}
+
+// ChunkView implementation
+template <typename T, typename Storage>
+VectorView<T> LazyVector<T, Storage>::ChunkView(size_t chunk) {
+    return VectorView<T>(StorageTraits<Storage>::ChunkData(m_stlVector, chunk),
+                         StorageTraits<Storage>::ChunkLength(m_stlVector, chunk));
+}
+
+// begin implementation
+template <typename T, typename Storage>
+typename LazyVector<T, Storage>::iterator LazyVector<T, Storage>::begin() {
+    return m_stlVector.begin();
+}
+
+// end implementation
+template <typename T, typename Storage>
+typename LazyVector<T, Storage>::iterator LazyVector<T, Storage>::end() {
+    return m_stlVector.end();
+}
+
+// Release implementation
+template <typename T, typename Storage>
+Storage LazyVector<T, Storage>::Release() {
+    Storage stlVector(std::move(m_stlVector));
+    m_stlVector.clear();
+
+    m_eOperator = Operator::Unknown;
+    m_stlOtherVector.clear();
+    m_fnScan = nullptr;
+    m_nWindow = 0;
+
+    return stlVector;
+}
+
+// SaveBinary implementation
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::SaveBinary(const std::string& path) {
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    VectorFileHeader header = VectorFileFormat<T>::MakeHeader(m_stlVector.size());
+    std::vector<char> prefix(static_cast<size_t>(header.nDataOffset), 0);
+    std::memcpy(&prefix[0], &header, sizeof(header));
+    file.write(&prefix[0], prefix.size());
+
+    for (size_t chunk = 0; chunk < StorageTraits<Storage>::ChunkCount(m_stlVector); chunk++) {
+        const T* data = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        file.write(reinterpret_cast<const char*>(data), StorageTraits<Storage>::ChunkLength(m_stlVector, chunk) * sizeof(T));
+    }
+
+    if (!file.flush()) {
+        throw std::runtime_error("Unable to write " + path);
+    }
+}
+
+// LoadBinary implementation
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::LoadBinary(const std::string& path) {
+    if (m_eOperator != Operator::Unknown) {
+        throw std::invalid_argument(
+            "Invalid Operation: Vector should be operated on before it can be loaded.");
+    }
+
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    VectorFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::invalid_argument("File is not a LazyVector binary file.");
+    }
+    VectorFileFormat<T>::CheckHeader(header);
+
+    // The length is only trusted once the file is known to hold that many elements.
+    file.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    if (header.nDataOffset > fileSize || header.nLength > (fileSize - header.nDataOffset) / sizeof(T)) {
+        throw std::invalid_argument("LazyVector binary file is truncated.");
+    }
+
+    file.seekg(static_cast<std::streamoff>(header.nDataOffset));
+    m_stlVector.clear();
+    m_stlVector.resize(static_cast<size_t>(header.nLength));
+
+    for (size_t chunk = 0; chunk < StorageTraits<Storage>::ChunkCount(m_stlVector); chunk++) {
+        T* data = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        if (!file.read(reinterpret_cast<char*>(data), StorageTraits<Storage>::ChunkLength(m_stlVector, chunk) * sizeof(T))) {
+            m_stlVector.clear();
+            throw std::invalid_argument("LazyVector binary file is truncated.");
+        }
+    }
+}
+
+// SaveText implementation
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::SaveText(const std::string& path) {
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    const size_t bufferSize = 1 << 20;
+    std::vector<char> buffer(bufferSize);
+    char* cursor = &buffer[0];
+    char* limit = &buffer[0] + bufferSize - VectorFileFormat<T>::kMaxTextLength - 1;
+
+    for (size_t chunk = 0; chunk < StorageTraits<Storage>::ChunkCount(m_stlVector); chunk++) {
+        const T* data = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        for (size_t i = 0; i < length; i++) {
+            if (cursor >= limit) {
+                file.write(&buffer[0], cursor - &buffer[0]);
+                cursor = &buffer[0];
+            }
+
+            cursor = VectorFileFormat<T>::FormatElement(cursor, data[i]);
+            *cursor++ = ' ';
+        }
+    }
+
+    *cursor++ = '\n';
+    file.write(&buffer[0], cursor - &buffer[0]);
+
+    if (!file.flush()) {
+        throw std::runtime_error("Unable to write " + path);
+    }
+}
+
+// LoadText implementation
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::LoadText(const std::string& path) {
+    if (m_eOperator != Operator::Unknown) {
+        throw std::invalid_argument(
+            "Invalid Operation: Vector should be operated on before it can be loaded.");
+    }
+
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    const size_t bufferSize = 1 << 20;
+    std::vector<char> buffer(bufferSize + 1);
+    size_t carried = 0;
+    bool endOfFile = false;
+
+    m_stlVector.clear();
+
+    while (!endOfFile) {
+        file.read(&buffer[carried], bufferSize - carried);
+        size_t available = carried + static_cast<size_t>(file.gcount());
+        endOfFile = !file;
+
+        // Only text up to the last separator holds complete elements; the rest is carried over.
+        size_t complete = available;
+        if (!endOfFile) {
+            while (complete > 0 && !std::isspace(static_cast<unsigned char>(buffer[complete - 1]))) {
+                complete--;
+            }
+
+            if (complete == 0) {
+                m_stlVector.clear();
+                throw std::invalid_argument("Text file holds an element that is too long.");
+            }
+        }
+
+        // Terminate the parsed region so that no element can run past it.
+        char terminator = buffer[complete];
+        buffer[complete] = '\0';
+
+        const char* cursor = &buffer[0];
+        const char* last = &buffer[0] + complete;
+        while (cursor < last) {
+            if (std::isspace(static_cast<unsigned char>(*cursor))) {
+                cursor++;
+                continue;
+            }
+
+            T value;
+            const char* next = VectorFileFormat<T>::ParseElement(cursor, last, value);
+            if (next == cursor || (next < last && !std::isspace(static_cast<unsigned char>(*next)))) {
+                m_stlVector.clear();
+                throw std::invalid_argument("Text file holds an invalid element.");
+            }
+
+            m_stlVector.push_back(value);
+            cursor = next;
+        }
+
+        buffer[complete] = terminator;
+        carried = available - complete;
+        std::memmove(&buffer[0], &buffer[complete], carried);
+    }
 }
 
 // Subscript operator implementation
-template <typename T>
-T& LazyVector<T>::operator[](int index) {
+template <typename T, typename Storage>
+T& LazyVector<T, Storage>::operator[](int index) {
     return m_stlVector[index];
 }
 
 // Private: addVectors implementation
-template <typename T>
-void LazyVector<T>::addVectors() {
-    for (int i = 0; i < m_stlVector.size(); i++) {
-        m_stlVector[i] += m_stlOtherVector[i];
-    }
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::addVectors() {
+    StorageTraits<Storage>::ForEachChunk(StorageTraits<Storage>::ChunkCount(m_stlVector), [this](size_t chunk) {
+        T* lhs = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        const T* rhs = StorageTraits<Storage>::ChunkData(m_stlOtherVector, chunk);
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        for (size_t i = 0; i < length; i++) {
+            lhs[i] += rhs[i];
+        }
+    });
 }
 
 // Private: subtractVectors implementation
-template <typename T>
-void LazyVector<T>::subtractVectors() {
-    for (int i = 0; i < m_stlVector.size(); i++) {
-        m_stlVector[i] -= m_stlOtherVector[i];
-    }
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::subtractVectors() {
+    StorageTraits<Storage>::ForEachChunk(StorageTraits<Storage>::ChunkCount(m_stlVector), [this](size_t chunk) {
+        T* lhs = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        const T* rhs = StorageTraits<Storage>::ChunkData(m_stlOtherVector, chunk);
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        for (size_t i = 0; i < length; i++) {
+            lhs[i] -= rhs[i];
+        }
+    });
 }
 
 // Private: multiplyVectors implementation
-template <typename T>
-void LazyVector<T>::multiplyVectors() {
-    for (int i = 0; i < m_stlVector.size(); i++) {
-        m_stlVector[i] *= m_stlOtherVector[i];
-    }
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::multiplyVectors() {
+    StorageTraits<Storage>::ForEachChunk(StorageTraits<Storage>::ChunkCount(m_stlVector), [this](size_t chunk) {
+        T* lhs = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        const T* rhs = StorageTraits<Storage>::ChunkData(m_stlOtherVector, chunk);
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        for (size_t i = 0; i < length; i++) {
+            lhs[i] *= rhs[i];
+        }
+    });
 }
 
 // Private: divideVectors implementation
-template <typename T>
-void LazyVector<T>::divideVectors() {
-    for (int i = 0; i < m_stlVector.size(); i++) {
-        m_stlVector[i] /= m_stlOtherVector[i];
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::divideVectors() {
+    StorageTraits<Storage>::ForEachChunk(StorageTraits<Storage>::ChunkCount(m_stlVector), [this](size_t chunk) {
+        T* lhs = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        const T* rhs = StorageTraits<Storage>::ChunkData(m_stlOtherVector, chunk);
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        for (size_t i = 0; i < length; i++) {
+            lhs[i] /= rhs[i];
+        }
+    });
+}
+
+// Private: compareVectors implementation
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::compareVectors() {
+    Operator eOperator = m_eOperator;
+
+    StorageTraits<Storage>::ForEachChunk(StorageTraits<Storage>::ChunkCount(m_stlVector), [this, eOperator](size_t chunk) {
+        T* lhs = StorageTraits<Storage>::ChunkData(m_stlVector, chunk);
+        const T* rhs = StorageTraits<Storage>::ChunkData(m_stlOtherVector, chunk);
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        // The operator is resolved once per chunk so that every loop stays branch-free.
+        switch (eOperator) {
+        case Operator::Greater :
+            for (size_t i = 0; i < length; i++) lhs[i] = static_cast<T>(lhs[i] > rhs[i]);
+            break;
+        case Operator::GreaterEqual :
+            for (size_t i = 0; i < length; i++) lhs[i] = static_cast<T>(lhs[i] >= rhs[i]);
+            break;
+        case Operator::Less :
+            for (size_t i = 0; i < length; i++) lhs[i] = static_cast<T>(lhs[i] < rhs[i]);
+            break;
+        case Operator::LessEqual :
+            for (size_t i = 0; i < length; i++) lhs[i] = static_cast<T>(lhs[i] <= rhs[i]);
+            break;
+        case Operator::Equal :
+            for (size_t i = 0; i < length; i++) lhs[i] = static_cast<T>(lhs[i] == rhs[i]);
+            break;
+        default :
+            for (size_t i = 0; i < length; i++) lhs[i] = static_cast<T>(lhs[i] != rhs[i]);
+            break;
+        }
+    });
+}
+
+// Private: splitSegments implementation
+template <typename T, typename Storage>
+std::vector<typename LazyVector<T, Storage>::Segment> LazyVector<T, Storage>::splitSegments() {
+    const size_t segmentLength = 65536;
+    std::vector<Segment> segments;
+    size_t offset = 0;
+
+    for (size_t chunk = 0; chunk < StorageTraits<Storage>::ChunkCount(m_stlVector); chunk++) {
+        size_t length = StorageTraits<Storage>::ChunkLength(m_stlVector, chunk);
+
+        for (size_t begin = 0; begin < length; begin += segmentLength) {
+            Segment segment = { chunk, begin, offset + begin, std::min(segmentLength, length - begin) };
+            segments.push_back(segment);
+        }
+
+        offset += length;
     }
+
+    return segments;
+}
+
+// Private: scanVectors implementation
+template <typename T, typename Storage>
+template <typename Function>
+void LazyVector<T, Storage>::scanVectors(Function op) {
+    std::vector<Segment> segments = splitSegments();
+    std::vector<T> carries(segments.size());
+
+    // Segments are spread over threads even for contiguous storage.
+    if (segments.size() > 1) {
+        std::vector<T> totals(segments.size());
+
+        WorkerPool::ParallelFor(segments.size(), [&](size_t index) {
+            const Segment& segment = segments[index];
+            const T* data = StorageTraits<Storage>::ChunkData(m_stlVector, segment.nChunk) + segment.nBegin;
+
+            T total = data[0];
+            for (size_t i = 1; i < segment.nLength; i++) {
+                total = op(total, data[i]);
+            }
+            totals[index] = total;
+        });
+
+        carries[1] = totals[0];
+        for (size_t index = 2; index < segments.size(); index++) {
+            carries[index] = op(carries[index - 1], totals[index - 1]);
+        }
+    }
+
+    WorkerPool::ParallelFor(segments.size(), [&](size_t index) {
+        const Segment& segment = segments[index];
+        T* data = StorageTraits<Storage>::ChunkData(m_stlVector, segment.nChunk) + segment.nBegin;
+
+        size_t i = 0;
+        T running = carries[index];
+        if (index == 0) {
+            running = data[0];
+            i = 1;
+        }
+
+        for (; i < segment.nLength; i++) {
+            running = op(running, data[i]);
+            data[i] = running;
+        }
+    });
+}
+
+// Private: rollVectors implementation
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::rollVectors() {
+    std::vector<Segment> segments = splitSegments();
+    const Storage& input = m_stlVector;
+    Storage result;
+    result.resize(m_stlVector.size());
+
+    Operator eOperator = m_eOperator;
+    size_t window = m_nWindow;
+
+    // Consecutive segments are grouped into runs of at least window elements, and each run replays
+    // the window - 1 elements before it once, so the replay never exceeds one extra pass.
+    std::vector<size_t> runs;
+    size_t runLength = 0;
+    for (size_t index = 0; index < segments.size(); index++) {
+        if (runs.empty() || runLength >= window) {
+            runs.push_back(index);
+            runLength = 0;
+        }
+        runLength += segments[index].nLength;
+    }
+    runs.push_back(segments.size());
+
+    WorkerPool::ParallelFor(runs.size() - 1, [&](size_t run) {
+        size_t first = segments[runs[run]].nOffset;
+        size_t start = first >= window - 1 ? first - (window - 1) : 0;
+
+        if (eOperator == Operator::WindowSum || eOperator == Operator::WindowMean) {
+            // Running sum of the current window: add the entering element, drop the leaving one.
+            // For floating-point T the rounding error of every update is recovered exactly (TwoSum) and
+            // kept in error, so small elements are not lost when a much larger one leaves the window.
+            T sum = T(0);
+            T error = T(0);
+            auto accumulate = [&sum, &error](T value, bool leaving) {
+                T total = leaving ? sum - value : sum + value;
+                if (std::is_floating_point<T>::value) {
+                    T change = leaving ? -value : value;
+                    T added = total - sum;
+                    error += (sum - (total - added)) + (change - added);
+                }
+                sum = total;
+            };
+
+            for (size_t j = start; j < first; j++) {
+                accumulate(input[j], false);
+            }
+
+            for (size_t index = runs[run]; index < runs[run + 1]; index++) {
+                const Segment& segment = segments[index];
+                T* output = StorageTraits<Storage>::ChunkData(result, segment.nChunk) + segment.nBegin;
+
+                for (size_t i = segment.nOffset; i < segment.nOffset + segment.nLength; i++) {
+                    accumulate(input[i], false);
+                    if (i >= window && i - window >= start) {
+                        accumulate(input[i - window], true);
+                    }
+
+                    if (eOperator == Operator::WindowSum) {
+                        output[i - segment.nOffset] = sum + error;
+                    } else {
+                        output[i - segment.nOffset] = (sum + error) / static_cast<T>(std::min(i + 1, window));
+                    }
+                }
+            }
+        } else {
+            // Monotonic queue of indices: the front is the extreme of the current window.
+            bool isMin = eOperator == Operator::WindowMin;
+            std::deque<size_t> candidates;
+
+            auto enqueue = [&](size_t i) {
+                while (!candidates.empty() &&
+                       (isMin ? !(input[candidates.back()] < input[i]) : !(input[i] < input[candidates.back()]))) {
+                    candidates.pop_back();
+                }
+                candidates.push_back(i);
+            };
+
+            for (size_t j = start; j < first; j++) {
+                enqueue(j);
+            }
+
+            for (size_t index = runs[run]; index < runs[run + 1]; index++) {
+                const Segment& segment = segments[index];
+                T* output = StorageTraits<Storage>::ChunkData(result, segment.nChunk) + segment.nBegin;
+
+                for (size_t i = segment.nOffset; i < segment.nOffset + segment.nLength; i++) {
+                    enqueue(i);
+                    while (candidates.front() + window <= i) {
+                        candidates.pop_front();
+                    }
+                    output[i - segment.nOffset] = input[candidates.front()];
+                }
+            }
+        }
+    });
+
+    m_stlVector = std::move(result);
+}
+
+// Private: storeWindow implementation
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::storeWindow(Operator eOperator, size_t window) {
+    if (window == 0) {
+        throw std::invalid_argument("Window size should be greater than zero.");
+    }
+
+    this->m_eOperator = eOperator;
+    this->m_nWindow = window;
+    this->m_stlOtherVector.clear();
+    return *this;
+}
+
+// Private: storeComparison implementation
+template <typename T, typename Storage>
+LazyVector<T, Storage> LazyVector<T, Storage>::storeComparison(Operator eOperator, LazyVector<T, Storage>& otherVector) {
+    if (m_stlVector.size() != otherVector.size()) {
+        throw std::invalid_argument("Vectors to be compared should have same size.");
+    }
+
+    this->m_eOperator = eOperator;
+    this->m_stlOtherVector = otherVector.m_stlVector;
+    return *this;
 }
 
 // Private: performOperation implementation
-template <typename T>
-void LazyVector<T>::performOperation() {
+template <typename T, typename Storage>
+void LazyVector<T, Storage>::performOperation() {
     switch (m_eOperator) {
     case Operator::Add :
         this->addVectors();
@@ -186,6 +781,29 @@ void LazyVector<T>::performOperation() {
     case Operator::Divide :
         this->divideVectors();
         break;
+    case Operator::Greater :
+    case Operator::GreaterEqual :
+    case Operator::Less :
+    case Operator::LessEqual :
+    case Operator::Equal :
+    case Operator::NotEqual :
+        this->compareVectors();
+        break;
+    case Operator::CumulativeSum :
+        this->scanVectors(std::plus<T>());
+        break;
+    case Operator::CumulativeProduct :
+        this->scanVectors(std::multiplies<T>());
+        break;
+    case Operator::PrefixScan :
+        this->scanVectors(m_fnScan);
+        break;
+    case Operator::WindowSum :
+    case Operator::WindowMean :
+    case Operator::WindowMin :
+    case Operator::WindowMax :
+        this->rollVectors();
+        break;
     default :
         throw std::invalid_argument("Invalid Operation");
         break;
@@ -193,4 +811,6 @@ void LazyVector<T>::performOperation() {
 
     this->m_eOperator = Operator::Unknown;
     this->m_stlOtherVector.clear();
+    this->m_fnScan = nullptr;
+    this->m_nWindow = 0;
 }
@@ -11,8 +11,20 @@
 #define LAZYVECTOR_H
 
 #include <iostream>
+#include <fstream>
+#include <string>
 #include <vector>
+#include <cctype>
+#include <cstring>
 #include <stdexcept>
+#include <utility>
+#include <deque>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "ChunkedVector.h"
+#include "VectorFile.h"
 
 /**
  * Enum representing the available arithmetic operations for LazyVector.
@@ -22,16 +34,147 @@
  * - Subtract: Vector subtraction
  * - Divide: Element-wise division
  * - Multiply: Element-wise multiplication
+ * - Greater, GreaterEqual, Less, LessEqual, Equal, NotEqual: Element-wise
+ *   comparisons producing a mask (1 where the comparison holds, 0 elsewhere)
+ * - MaskedSelect: Element-wise choice between two vectors driven by a mask
+ * - CumulativeSum, CumulativeProduct, PrefixScan: Inclusive prefix scans
+ * - WindowSum, WindowMean, WindowMin, WindowMax: Trailing rolling-window aggregates
  * - Unknown: No operation set (default state)
  */
 enum Operator {
-    Add = 0,        ///< Addition operation
-    Subtract,       ///< Subtraction operation
-    Divide,         ///< Division operation
-    Multiply,       ///< Multiplication operation
-    Unknown         ///< Unknown/no operation
+    Add = 0,            ///< Addition operation
+    Subtract,           ///< Subtraction operation
+    Divide,             ///< Division operation
+    Multiply,           ///< Multiplication operation
+    Greater,            ///< Greater-than comparison
+    GreaterEqual,       ///< Greater-or-equal comparison
+    Less,               ///< Less-than comparison
+    LessEqual,          ///< Less-or-equal comparison
+    Equal,              ///< Equality comparison
+    NotEqual,           ///< Inequality comparison
+    MaskedSelect,       ///< Masked selection (evaluation plans only)
+    CumulativeSum,      ///< Running sum
+    CumulativeProduct,  ///< Running product
+    PrefixScan,         ///< Running scan with a custom associative operation
+    WindowSum,          ///< Rolling-window sum
+    WindowMean,         ///< Rolling-window mean
+    WindowMin,          ///< Rolling-window minimum
+    WindowMax,          ///< Rolling-window maximum
+    Unknown             ///< Unknown/no operation
+};
+
+/**
+ * StorageTraits class template.
+ *
+ * Describes how LazyVector walks its storage chunk by chunk so that the
+ * evaluation kernels run over plain contiguous arrays. Any contiguous
+ * vector-like container (such as std::vector) is treated as a single chunk.
+ *
+ * Template Parameters:
+ *   Storage - The container type used by LazyVector
+ */
+template <typename Storage>
+struct StorageTraits {
+    typedef typename Storage::value_type value_type;
+
+    static size_t ChunkCount(const Storage& storage) { return storage.empty() ? 0 : 1; }
+    static value_type* ChunkData(Storage& storage, size_t) { return storage.data(); }
+    static const value_type* ChunkData(const Storage& storage, size_t) { return storage.data(); }
+    static size_t ChunkLength(const Storage& storage, size_t) { return storage.size(); }
+
+    template <typename Function>
+    static void ForEachChunk(size_t chunkCount, Function function) {
+        for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+            function(chunk);
+        }
+    }
+};
+
+/**
+ * StorageTraits specialization for ChunkedVector.
+ *
+ * Chunks are evaluated in parallel through ChunkedVector::ParallelForChunks.
+ * Only chunks allocated by the sized constructor or resize are first touched
+ * by the worker that evaluates them; those added by PushValue or LoadText are
+ * allocated on the calling thread.
+ */
+template <typename T, size_t ChunkSize, size_t Alignment>
+struct StorageTraits<ChunkedVector<T, ChunkSize, Alignment> > {
+    typedef ChunkedVector<T, ChunkSize, Alignment> Storage;
+    typedef T value_type;
+
+    static size_t ChunkCount(const Storage& storage) { return storage.ChunkCount(); }
+    static T* ChunkData(Storage& storage, size_t chunk) { return storage.ChunkData(chunk); }
+    static const T* ChunkData(const Storage& storage, size_t chunk) { return storage.ChunkData(chunk); }
+    static size_t ChunkLength(const Storage& storage, size_t chunk) { return storage.ChunkLength(chunk); }
+
+    template <typename Function>
+    static void ForEachChunk(size_t chunkCount, Function function) {
+        Storage::ParallelForChunks(chunkCount, function);
+    }
+};
+
+/**
+ * VectorView class template.
+ *
+ * A non-owning view of contiguous elements, in the spirit of std::span.
+ * It stays valid until the viewed LazyVector is resized, released or destroyed.
+ *
+ * Template Parameters:
+ *   T - The data type of the viewed elements
+ */
+template <typename T>
+class VectorView {
+public:
+    /**
+     * Constructor.
+     * Views size elements starting at pData.
+     *
+     * Parameters:
+     *   pData - The first viewed element
+     *   size  - The number of viewed elements
+     */
+    VectorView(T* pData, size_t size) : m_pData(pData), m_nSize(size) {}
+
+    /**
+     * Returns a pointer to the first viewed element.
+     */
+    T* data() const { return m_pData; }
+
+    /**
+     * Returns the number of viewed elements.
+     */
+    size_t size() const { return m_nSize; }
+
+    /**
+     * Returns whether the view holds no elements.
+     */
+    bool empty() const { return m_nSize == 0; }
+
+    /**
+     * Iterator access over the viewed elements.
+     */
+    T* begin() const { return m_pData; }
+    T* end() const { return m_pData + m_nSize; }
+
+    /**
+     * Subscript operator overload for element access.
+     *
+     * Parameters:
+     *   index - The zero-based index of the element inside the view
+     *
+     * Returns:
+     *   A reference to the element at the specified index
+     */
+    T& operator[](size_t index) const { return m_pData[index]; }
+
+private:
+    T* m_pData;         ///< The first viewed element
+    size_t m_nSize;     ///< The number of viewed elements
 };
 
+template <typename T, typename Storage> class EvaluationPlan;
+
 /**
  * LazyVector class template.
  * 
@@ -41,16 +184,43 @@ enum Operator {
  * This approach optimizes memory and computation by deferring operations.
  * 
  * Template Parameters:
- *   T - The data type of elements stored in the vector (must support arithmetic operations)
+ *   T       - The data type of elements stored in the vector (must support arithmetic operations)
+ *   Storage - The container holding the elements: std::vector<T> (default) or ChunkedVector<T>
  */
-template <typename T>
+template <typename T, typename Storage = std::vector<T> >
 class LazyVector {
 public:
+    typedef typename Storage::iterator iterator;  ///< Iterator over the elements
+
     /**
      * Default constructor.
      * Initializes an empty LazyVector with no pending operations.
      */
-    LazyVector() : m_eOperator(Operator::Unknown) {}
+    LazyVector() : m_eOperator(Operator::Unknown), m_nWindow(0) {}
+
+    /**
+     * Sized constructor.
+     * Initializes a LazyVector holding count value-initialized elements.
+     * With ChunkedVector storage the chunks are allocated in parallel (see
+     * ChunkedVector::resize).
+     * 
+     * Parameters:
+     *   count - The number of elements
+     */
+    explicit LazyVector(size_t count) : m_eOperator(Operator::Unknown), m_nWindow(0) {
+        m_stlVector.resize(count);
+    }
+
+    /**
+     * Adopting constructor.
+     * Takes over an existing buffer as the contents of the vector without
+     * copying it. This is the counterpart of Release.
+     * 
+     * Parameters:
+     *   storage - The buffer to adopt (will be left empty after construction)
+     */
+    explicit LazyVector(Storage&& storage)
+        : m_stlVector(std::move(storage)), m_eOperator(Operator::Unknown), m_nWindow(0) {}
 
     /**
      * Move constructor.
@@ -59,7 +229,7 @@ public:
      * Parameters:
      *   other - The LazyVector to move from (will be left empty after construction)
      */
-    LazyVector(LazyVector<T>&& other);
+    LazyVector(LazyVector<T, Storage>&& other);
 
     /**
      * Copy constructor.
@@ -69,7 +239,7 @@ public:
      * Parameters:
      *   other - The LazyVector to copy from
      */
-    LazyVector(const LazyVector<T>& other);
+    LazyVector(const LazyVector<T, Storage>& other);
 
     /**
      * Adds a value to the vector.
@@ -101,7 +271,7 @@ public:
      * Throws:
      *   std::invalid_argument - If vectors have different sizes
      */
-    LazyVector<T> operator+(LazyVector<T>& otherVector);
+    LazyVector<T, Storage> operator+(LazyVector<T, Storage>& otherVector);
 
     /**
      * Subtraction operator overload.
@@ -118,7 +288,7 @@ public:
      * Throws:
      *   std::invalid_argument - If vectors have different sizes
      */
-    LazyVector<T> operator-(LazyVector<T>& otherVector);
+    LazyVector<T, Storage> operator-(LazyVector<T, Storage>& otherVector);
 
     /**
      * Multiplication operator overload.
@@ -135,7 +305,7 @@ public:
      * Throws:
      *   std::invalid_argument - If vectors have different sizes
      */
-    LazyVector<T> operator*(LazyVector<T>& otherVector);
+    LazyVector<T, Storage> operator*(LazyVector<T, Storage>& otherVector);
 
     /**
      * Division operator overload.
@@ -152,7 +322,102 @@ public:
      * Throws:
      *   std::invalid_argument - If vectors have different sizes
      */
-    LazyVector<T> operator/(LazyVector<T>& otherVector);
+    LazyVector<T, Storage> operator/(LazyVector<T, Storage>& otherVector);
+
+    /**
+     * Comparison operator overloads.
+     * 
+     * Perform a lazy element-wise comparison. Store the operation and the
+     * second vector without immediately computing the result. The result is
+     * a mask holding 1 where the comparison holds and 0 elsewhere.
+     * 
+     * Parameters:
+     *   otherVector - The vector to compare this vector with
+     * 
+     * Returns:
+     *   A reference to this LazyVector with the pending operation stored
+     * 
+     * Throws:
+     *   std::invalid_argument - If vectors have different sizes
+     */
+    LazyVector<T, Storage> operator>(LazyVector<T, Storage>& otherVector);
+    LazyVector<T, Storage> operator>=(LazyVector<T, Storage>& otherVector);
+    LazyVector<T, Storage> operator<(LazyVector<T, Storage>& otherVector);
+    LazyVector<T, Storage> operator<=(LazyVector<T, Storage>& otherVector);
+    LazyVector<T, Storage> operator==(LazyVector<T, Storage>& otherVector);
+    LazyVector<T, Storage> operator!=(LazyVector<T, Storage>& otherVector);
+
+    /**
+     * Replaces the elements selected by a mask.
+     * 
+     * Every element where mask is non-zero is replaced by the corresponding
+     * element of values; the others are kept. The loop is a branch-free blend
+     * evaluated chunk by chunk. The stored elements of mask and values are read,
+     * as views do. Any pending operation left on this vector by an earlier
+     * operator is discarded.
+     * 
+     * Parameters:
+     *   mask   - The mask, such as the result of a comparison
+     *   values - The replacement values
+     * 
+     * Throws:
+     *   std::invalid_argument - If vectors have different sizes
+     */
+    void MaskedAssign(LazyVector<T, Storage>& mask, LazyVector<T, Storage>& values);
+
+    /**
+     * Cumulative sum and product.
+     * 
+     * Store a lazy inclusive prefix scan: element i of the result combines
+     * elements 0..i. The scan runs in parallel as a blocked two-pass scan.
+     * 
+     * Returns:
+     *   A reference to this LazyVector with the pending operation stored
+     */
+    LazyVector<T, Storage> CumSum();
+    LazyVector<T, Storage> CumProd();
+
+    /**
+     * Prefix scan with a custom operation.
+     * 
+     * Stores a lazy inclusive prefix scan: element i of the result is
+     * op(...op(op(v[0], v[1]), v[2])..., v[i]). The scan is evaluated in
+     * blocks on several threads, so op must be associative. An exception
+     * thrown by op is rethrown where the scan is evaluated.
+     * 
+     * Parameters:
+     *   op - The associative operation, such as a maximum for a running max
+     * 
+     * Returns:
+     *   A reference to this LazyVector with the pending operation stored
+     * 
+     * Throws:
+     *   std::invalid_argument - If op is empty
+     */
+    LazyVector<T, Storage> Scan(std::function<T(T, T)> op);
+
+    /**
+     * Rolling-window aggregates.
+     * 
+     * Store a lazy trailing-window aggregate: element i of the result
+     * aggregates elements max(0, i - window + 1)..i, so the first window - 1
+     * results cover partial windows. Each element costs O(1) amortized
+     * (running sum, monotonic queue for min and max) and blocks of the vector
+     * are evaluated on several threads.
+     * 
+     * Parameters:
+     *   window - The number of elements in a full window
+     * 
+     * Returns:
+     *   A reference to this LazyVector with the pending operation stored
+     * 
+     * Throws:
+     *   std::invalid_argument - If window is zero
+     */
+    LazyVector<T, Storage> RollingSum(size_t window);
+    LazyVector<T, Storage> RollingMean(size_t window);
+    LazyVector<T, Storage> RollingMin(size_t window);
+    LazyVector<T, Storage> RollingMax(size_t window);
 
     /**
      * Assignment operator overload.
@@ -166,7 +431,7 @@ public:
      * Returns:
      *   A reference to this LazyVector after assignment
      */
-    LazyVector<T>& operator=(LazyVector<T>& otherVector);
+    LazyVector<T, Storage>& operator=(LazyVector<T, Storage>& otherVector);
 
     /**
      * Returns the size of the vector.
@@ -185,12 +450,126 @@ public:
 
     /**
      * Returns a copy of the internal vector.
+     * Use data(), View(), ChunkView() or Release() to hand the elements over without copying.
      * 
      * Returns:
      *   A std::vector<T> containing all elements
      */
     std::vector<T> GetVector();
 
+    /**
+     * Returns a pointer to the first element, without copying.
+     * Only available for contiguous storage such as std::vector.
+     * 
+     * Returns:
+     *   A pointer to the elements, valid until the vector is resized, released or destroyed
+     */
+    T* data();
+
+    /**
+     * Returns a non-owning view of all elements, without copying.
+     * Only available for contiguous storage such as std::vector.
+     * 
+     * Returns:
+     *   A VectorView over the elements
+     */
+    VectorView<T> View();
+
+    /**
+     * Returns the number of storage chunks.
+     * Contiguous storage is a single chunk.
+     */
+    size_t ChunkCount();
+
+    /**
+     * Returns a non-owning view of one storage chunk, without copying.
+     * Available for every storage, including ChunkedVector.
+     * 
+     * Parameters:
+     *   chunk - The zero-based index of the chunk
+     * 
+     * Returns:
+     *   A VectorView over the elements of the chunk
+     */
+    VectorView<T> ChunkView(size_t chunk);
+
+    /**
+     * Iterator access over the elements, in index order.
+     */
+    iterator begin();
+    iterator end();
+
+    /**
+     * Moves the underlying storage out of the vector, without copying.
+     * 
+     * The vector is left empty and any pending operation is discarded.
+     * The storage can be handed back with the adopting constructor.
+     * 
+     * Returns:
+     *   The storage holding the elements
+     */
+    Storage Release();
+
+    /**
+     * Writes the vector to a binary file.
+     * 
+     * The file starts with a VectorFileHeader (element type, length and
+     * alignment) followed by the raw elements, written one chunk at a time.
+     * It can be read back with LoadBinary or mapped with MappedVector.
+     * 
+     * Parameters:
+     *   path - The path of the file to write
+     * 
+     * Throws:
+     *   std::runtime_error - If the file cannot be written
+     */
+    void SaveBinary(const std::string& path);
+
+    /**
+     * Replaces the contents of the vector with a binary file.
+     * 
+     * Elements are read directly into the storage, one chunk at a time.
+     * 
+     * Parameters:
+     *   path - The path of a file written by SaveBinary
+     * 
+     * Throws:
+     *   std::invalid_argument - If there are pending operations, the file does not hold elements of type T
+     *                           or it is shorter than its header states
+     *   std::runtime_error    - If the file cannot be read
+     */
+    void LoadBinary(const std::string& path);
+
+    /**
+     * Writes the vector to a text file.
+     * 
+     * Elements are formatted into a large buffer with the shortest text that
+     * reads back to the same value and written separated by spaces, followed
+     * by a newline, the same layout as PrintVector.
+     * 
+     * Parameters:
+     *   path - The path of the file to write
+     * 
+     * Throws:
+     *   std::runtime_error - If the file cannot be written
+     */
+    void SaveText(const std::string& path);
+
+    /**
+     * Replaces the contents of the vector with a text file.
+     * 
+     * The file is read in large blocks and elements separated by whitespace
+     * are parsed in place.
+     * 
+     * Parameters:
+     *   path - The path of the file to read
+     * 
+     * Throws:
+     *   std::invalid_argument - If there are pending operations or the file holds an invalid element
+     *   std::runtime_error    - If the file cannot be read
+     */
+    void LoadText(const std::string& path);
+
     /**
      * Subscript operator overload for element access.
      * 
@@ -237,10 +616,83 @@ private:
      */
     void divideVectors();
 
+    /**
+     * Performs an element-wise comparison of vectors.
+     * 
+     * Replaces each element of m_stlVector by 1 if it compares to the
+     * corresponding element of m_stlOtherVector as the pending operator
+     * requires, and by 0 otherwise.
+     */
+    void compareVectors();
+
+    /**
+     * Contiguous run of elements inside one storage chunk, the unit of work
+     * of scans and rolling windows.
+     */
+    struct Segment {
+        size_t nChunk;      ///< The chunk holding the run
+        size_t nBegin;      ///< The index of the first element inside the chunk
+        size_t nOffset;     ///< The index of the first element in the vector
+        size_t nLength;     ///< The number of elements
+    };
+
+    /**
+     * Splits the storage into segments of at most 64K elements that never
+     * cross a chunk, in element order.
+     */
+    std::vector<Segment> splitSegments();
+
+    /**
+     * Performs an inclusive prefix scan of m_stlVector in place.
+     * 
+     * Blocked two-pass scan: every segment is first reduced in parallel,
+     * the segment totals are scanned serially into carries, and every segment
+     * is then scanned in parallel starting from its carry.
+     * 
+     * Parameters:
+     *   op - The associative operation
+     */
+    template <typename Function>
+    void scanVectors(Function op);
+
+    /**
+     * Performs the pending rolling-window aggregate of m_stlVector.
+     * 
+     * Segments are grouped into runs of at least window elements, which are
+     * evaluated in parallel into a new storage. Each run first replays the
+     * window - 1 elements preceding it, so every element is read at most
+     * about twice whatever the window size.
+     */
+    void rollVectors();
+
+    /**
+     * Stores a pending rolling-window operation.
+     * 
+     * Throws:
+     *   std::invalid_argument - If window is zero
+     */
+    LazyVector<T, Storage> storeWindow(Operator eOperator, size_t window);
+
+    /**
+     * Stores a pending comparison after checking the operand sizes.
+     * 
+     * Parameters:
+     *   eOperator   - The comparison to store
+     *   otherVector - The second operand
+     * 
+     * Returns:
+     *   A copy of this LazyVector, holding the evaluated mask
+     * 
+     * Throws:
+     *   std::invalid_argument - If vectors have different sizes
+     */
+    LazyVector<T, Storage> storeComparison(Operator eOperator, LazyVector<T, Storage>& otherVector);
+
     /**
      * Executes the pending arithmetic operation.
      * 
      * Checks the stored operator and calls the appropriate operation function.
+     * Each operation runs its loop chunk by chunk as described by StorageTraits.
      * After execution, clears the pending operation and the temporary vector.
      * 
      * Throws:
@@ -249,9 +701,13 @@ private:
     void performOperation();
 
 private:
-    std::vector<T> m_stlVector;         ///< The main vector storing elements
+    Storage m_stlVector;                ///< The main vector storing elements
     Operator m_eOperator;               ///< The pending arithmetic operation
-    std::vector<T> m_stlOtherVector;    ///< Temporary vector for the second operand
+    Storage m_stlOtherVector;           ///< Temporary vector for the second operand
+    std::function<T(T, T)> m_fnScan;   ///< The operation of a pending PrefixScan
+    size_t m_nWindow;                   ///< The window size of a pending rolling-window operation
+
+    template <typename U, typename S> friend class EvaluationPlan;
 };
 
 // Include the implementation file
@@ -0,0 +1,258 @@
+/**
+ * VectorFile.cc
+ *
+ * Implementation file for VectorFileFormat and MappedVector template classes.
+ * Contains the definitions of all member functions.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define LAZYVECTOR_HAS_MMAP 1
+#endif
+
+template <typename T> const uint32_t VectorFileFormat<T>::kVersion;
+template <typename T> const uint32_t VectorFileFormat<T>::kByteOrder;
+template <typename T> const uint32_t VectorFileFormat<T>::kAlignment;
+template <typename T> const size_t VectorFileFormat<T>::kMaxTextLength;
+
+// VectorFileFormat: TypeCode implementation
+template <typename T>
+uint32_t VectorFileFormat<T>::TypeCode() {
+    uint32_t kind = std::is_floating_point<T>::value ? 'f' : (std::is_signed<T>::value ? 'i' : 'u');
+    return (kind << 8) | static_cast<uint32_t>(sizeof(T));
+}
+
+// VectorFileFormat: MakeHeader implementation
+template <typename T>
+VectorFileHeader VectorFileFormat<T>::MakeHeader(uint64_t length) {
+    VectorFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.szMagic, "LAZYVEC", 8);
+
+    header.nVersion = kVersion;
+    header.nByteOrder = kByteOrder;
+    header.nTypeCode = TypeCode();
+    header.nElementSize = sizeof(T);
+    header.nAlignment = kAlignment;
+    header.nLength = length;
+    header.nDataOffset = (sizeof(VectorFileHeader) + kAlignment - 1) / kAlignment * kAlignment;
+
+    return header;
+}
+
+// VectorFileFormat: CheckHeader implementation
+template <typename T>
+void VectorFileFormat<T>::CheckHeader(const VectorFileHeader& header) {
+    if (std::memcmp(header.szMagic, "LAZYVEC", 8) != 0) {
+        throw std::invalid_argument("File is not a LazyVector binary file.");
+    }
+
+    if (header.nVersion != kVersion) {
+        throw std::invalid_argument("LazyVector binary file has an unsupported version.");
+    }
+
+    if (header.nByteOrder != kByteOrder) {
+        throw std::invalid_argument("LazyVector binary file was written with a different byte order.");
+    }
+
+    if (header.nTypeCode != TypeCode() || header.nElementSize != sizeof(T)) {
+        throw std::invalid_argument("LazyVector binary file holds a different element type.");
+    }
+
+    if (header.nAlignment == 0 || header.nDataOffset < sizeof(VectorFileHeader) ||
+        header.nDataOffset % header.nAlignment != 0 || header.nDataOffset % alignof(T) != 0) {
+        throw std::invalid_argument("LazyVector binary file has an invalid data offset.");
+    }
+}
+
+#if __cplusplus >= 201703L
+
+// VectorFileFormat: FormatElement implementation
+template <typename T>
+char* VectorFileFormat<T>::FormatElement(char* buffer, T value) {
+    return std::to_chars(buffer, buffer + kMaxTextLength, value).ptr;
+}
+
+// VectorFileFormat: ParseElement implementation
+template <typename T>
+const char* VectorFileFormat<T>::ParseElement(const char* first, const char* last, T& value) {
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc() ? result.ptr : first;
+}
+
+#else
+
+// VectorFileFormat: FormatElement implementation
+template <typename T>
+char* VectorFileFormat<T>::FormatElement(char* buffer, T value) {
+    int length = 0;
+    if (std::is_floating_point<T>::value && sizeof(T) <= sizeof(double)) {
+        length = std::snprintf(buffer, kMaxTextLength, "%.*g",
+                               std::numeric_limits<T>::max_digits10, static_cast<double>(value));
+    } else if (std::is_floating_point<T>::value) {
+        length = std::snprintf(buffer, kMaxTextLength, "%.*Lg",
+                               std::numeric_limits<T>::max_digits10, static_cast<long double>(value));
+    } else if (std::is_signed<T>::value) {
+        length = std::snprintf(buffer, kMaxTextLength, "%lld", static_cast<long long>(value));
+    } else {
+        length = std::snprintf(buffer, kMaxTextLength, "%llu", static_cast<unsigned long long>(value));
+    }
+
+    return buffer + length;
+}
+
+// VectorFileFormat: ParseElement implementation
+template <typename T>
+const char* VectorFileFormat<T>::ParseElement(const char* first, const char*, T& value) {
+    // Reject what std::from_chars rejects: a leading '+', hexadecimal, '-' for unsigned types and
+    // values out of the range of T. Subnormal floating-point values are in range.
+    const char* digits = *first == '-' ? first + 1 : first;
+    if (*first == '+' || (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X'))) {
+        return first;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    if (std::is_floating_point<T>::value) {
+        // Parsing at the precision of T keeps the range checks below exact for T.
+        T parsed = sizeof(T) == sizeof(float) ? static_cast<T>(std::strtof(first, &end)) :
+                   sizeof(T) == sizeof(double) ? static_cast<T>(std::strtod(first, &end)) :
+                   static_cast<T>(std::strtold(first, &end));
+        // ERANGE is also set for subnormal results; only overflow and underflow to zero are out of range.
+        if (errno == ERANGE && (std::isinf(parsed) || parsed == T(0))) {
+            return first;
+        }
+        value = parsed;
+    } else if (std::is_signed<T>::value) {
+        long long parsed = std::strtoll(first, &end, 10);
+        if (errno == ERANGE || parsed < static_cast<long long>(std::numeric_limits<T>::min()) ||
+            parsed > static_cast<long long>(std::numeric_limits<T>::max())) {
+            return first;
+        }
+        value = static_cast<T>(parsed);
+    } else {
+        if (*first == '-') {
+            return first;
+        }
+
+        unsigned long long parsed = std::strtoull(first, &end, 10);
+        if (errno == ERANGE || parsed > static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+            return first;
+        }
+        value = static_cast<T>(parsed);
+    }
+
+    return end;
+}
+
+#endif
+
+// MappedVector: Constructor implementation
+template <typename T>
+MappedVector<T>::MappedVector(const std::string& path)
+    : m_pMapping(nullptr), m_nMappingSize(0), m_pData(nullptr), m_nSize(0) {
+#ifdef LAZYVECTOR_HAS_MMAP
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(VectorFileHeader)) {
+        ::close(descriptor);
+        throw std::invalid_argument("File is not a LazyVector binary file.");
+    }
+
+    m_nMappingSize = static_cast<size_t>(status.st_size);
+    m_pMapping = ::mmap(nullptr, m_nMappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+
+    if (m_pMapping == MAP_FAILED) {
+        m_pMapping = nullptr;
+        throw std::runtime_error("Unable to map " + path);
+    }
+
+    VectorFileHeader header;
+    std::memcpy(&header, m_pMapping, sizeof(header));
+
+    try {
+        VectorFileFormat<T>::CheckHeader(header);
+        if (header.nDataOffset > m_nMappingSize ||
+            header.nLength > (m_nMappingSize - header.nDataOffset) / sizeof(T)) {
+            throw std::invalid_argument("LazyVector binary file is truncated.");
+        }
+    } catch (...) {
+        ::munmap(m_pMapping, m_nMappingSize);
+        throw;
+    }
+
+    ::madvise(m_pMapping, m_nMappingSize, MADV_SEQUENTIAL);
+
+    m_pData = reinterpret_cast<const T*>(static_cast<const char*>(m_pMapping) + header.nDataOffset);
+    m_nSize = static_cast<size_t>(header.nLength);
+#else
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    VectorFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::invalid_argument("File is not a LazyVector binary file.");
+    }
+    VectorFileFormat<T>::CheckHeader(header);
+
+    file.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    if (header.nDataOffset > fileSize || header.nLength > (fileSize - header.nDataOffset) / sizeof(T)) {
+        throw std::invalid_argument("LazyVector binary file is truncated.");
+    }
+
+    m_stlFallback.resize(static_cast<size_t>(header.nLength));
+    file.seekg(static_cast<std::streamoff>(header.nDataOffset));
+    if (!file.read(reinterpret_cast<char*>(m_stlFallback.data()), m_stlFallback.size() * sizeof(T))) {
+        throw std::invalid_argument("LazyVector binary file is truncated.");
+    }
+
+    m_pData = m_stlFallback.data();
+    m_nSize = m_stlFallback.size();
+#endif
+}
+
+// MappedVector: Move constructor implementation
+template <typename T>
+MappedVector<T>::MappedVector(MappedVector<T>&& other)
+    : m_pMapping(other.m_pMapping), m_nMappingSize(other.m_nMappingSize), m_pData(other.m_pData),
+      m_nSize(other.m_nSize), m_stlFallback(std::move(other.m_stlFallback)) {
+    other.m_pMapping = nullptr;
+    other.m_nMappingSize = 0;
+    other.m_pData = nullptr;
+    other.m_nSize = 0;
+}
+
+// MappedVector: Destructor implementation
+template <typename T>
+MappedVector<T>::~MappedVector() {
+#ifdef LAZYVECTOR_HAS_MMAP
+    if (m_pMapping != nullptr) {
+        ::munmap(m_pMapping, m_nMappingSize);
+    }
+#endif
+}
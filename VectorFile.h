@@ -0,0 +1,185 @@
+/**
+ * VectorFile.h
+ *
+ * Header file for the LazyVector file formats: the binary file header, the
+ * text element conversions and MappedVector, a zero-copy read-only view of a
+ * binary file.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#ifndef VECTORFILE_H
+#define VECTORFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * Header at the start of a binary LazyVector file.
+ *
+ * The elements follow at nDataOffset as one contiguous array in the native
+ * byte order. nDataOffset is a multiple of nAlignment, so a file mapped at a
+ * page boundary exposes the elements with that alignment.
+ */
+struct VectorFileHeader {
+    char szMagic[8];            ///< File signature, "LAZYVEC" followed by a NUL
+    uint32_t nVersion;          ///< Format version
+    uint32_t nByteOrder;        ///< 0x01020304 written in the native byte order of the writer
+    uint32_t nTypeCode;         ///< Element kind and size, see VectorFileFormat::TypeCode
+    uint32_t nElementSize;      ///< sizeof(T) of the writer
+    uint32_t nAlignment;        ///< Alignment of the element array in bytes
+    uint32_t nReserved;         ///< Always zero
+    uint64_t nLength;           ///< The number of elements
+    uint64_t nDataOffset;       ///< Offset of the element array from the start of the file
+};
+
+/**
+ * VectorFileFormat class template.
+ *
+ * Encodes and checks binary file headers and converts single elements to and
+ * from text. Text conversions use std::to_chars/std::from_chars when compiled
+ * as C++17 and the C library otherwise.
+ *
+ * Template Parameters:
+ *   T - The arithmetic type of the elements
+ */
+template <typename T>
+struct VectorFileFormat {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic element types can be stored in files");
+
+    static const uint32_t kVersion = 1;             ///< Current format version
+    static const uint32_t kByteOrder = 0x01020304;  ///< Byte order marker
+    static const uint32_t kAlignment = 64;          ///< Alignment of the element array
+    static const size_t kMaxTextLength = 64;        ///< Upper bound of one formatted element
+
+    /**
+     * Returns the type code of T: its kind ('i', 'u' or 'f') shifted left
+     * by 8 bits, combined with sizeof(T).
+     */
+    static uint32_t TypeCode();
+
+    /**
+     * Builds the header of a file holding length elements of type T.
+     */
+    static VectorFileHeader MakeHeader(uint64_t length);
+
+    /**
+     * Checks that a header describes a file holding elements of type T.
+     *
+     * Throws:
+     *   std::invalid_argument - If the signature, version, byte order or element type do not match,
+     *                           or the data offset is not aligned for T
+     */
+    static void CheckHeader(const VectorFileHeader& header);
+
+    /**
+     * Writes the shortest text that reads back as value.
+     *
+     * Parameters:
+     *   buffer - Destination with room for at least kMaxTextLength characters
+     *   value  - The value to format
+     *
+     * Returns:
+     *   A pointer one past the last character written
+     */
+    static char* FormatElement(char* buffer, T value);
+
+    /**
+     * Parses one element at the start of [first, last).
+     * The character at last must be readable and must not be part of a number.
+     * C++11 and C++17 builds accept the same text: no leading '+', no
+     * hexadecimal, and no value outside the range of T. Subnormal values are
+     * accepted; values that overflow or underflow to zero are not.
+     *
+     * Returns:
+     *   A pointer one past the parsed text, or first if no element could be parsed
+     */
+    static const char* ParseElement(const char* first, const char* last, T& value);
+};
+
+/**
+ * MappedVector class template.
+ *
+ * A read-only view of the elements of a binary LazyVector file. On POSIX
+ * systems the file is memory mapped and the elements are used in place
+ * without being copied; elsewhere they are read into an owned buffer.
+ *
+ * Template Parameters:
+ *   T - The arithmetic type of the elements
+ */
+template <typename T>
+class MappedVector {
+public:
+    /**
+     * Constructor.
+     * Maps a binary file written by LazyVector::SaveBinary.
+     *
+     * Parameters:
+     *   path - The path of the file
+     *
+     * Throws:
+     *   std::runtime_error    - If the file cannot be opened or mapped
+     *   std::invalid_argument - If the file is not a LazyVector file of element type T
+     */
+    explicit MappedVector(const std::string& path);
+
+    /**
+     * Move constructor.
+     * Takes over the mapping of another MappedVector.
+     *
+     * Parameters:
+     *   other - The MappedVector to move from (will be left empty after construction)
+     */
+    MappedVector(MappedVector<T>&& other);
+
+    /**
+     * Destructor.
+     * Unmaps the file.
+     */
+    ~MappedVector();
+
+    /**
+     * Returns a pointer to the first element.
+     */
+    const T* data() const { return m_pData; }
+
+    /**
+     * Returns the number of elements.
+     */
+    size_t size() const { return m_nSize; }
+
+    /**
+     * Iterator access over the elements.
+     */
+    const T* begin() const { return m_pData; }
+    const T* end() const { return m_pData + m_nSize; }
+
+    /**
+     * Subscript operator overload for element access.
+     *
+     * Parameters:
+     *   index - The zero-based index of the element
+     */
+    const T& operator[](size_t index) const { return m_pData[index]; }
+
+private:
+    MappedVector(const MappedVector<T>&);
+    MappedVector<T>& operator=(const MappedVector<T>&);
+
+private:
+    void* m_pMapping;               ///< Start of the mapped file, or nullptr
+    size_t m_nMappingSize;          ///< Size of the mapping in bytes
+    const T* m_pData;               ///< The first element
+    size_t m_nSize;                 ///< The number of elements
+    std::vector<T> m_stlFallback;   ///< Owned elements when mapping is not available
+};
+
+// Include the implementation file
+#include "VectorFile.cc"
+
+#endif // VECTORFILE_H
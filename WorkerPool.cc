@@ -0,0 +1,194 @@
+/**
+ * WorkerPool.cc
+ *
+ * Implementation file for WorkerPool class.
+ * Contains the definitions of all member functions.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#define LAZYVECTOR_HAS_AFFINITY 1
+#endif
+
+#include <algorithm>
+
+// Instance implementation
+inline WorkerPool& WorkerPool::Instance() {
+    static WorkerPool pool;
+    return pool;
+}
+
+// Constructor implementation
+inline WorkerPool::WorkerPool()
+    : m_pTask(nullptr), m_nActive(0), m_nPending(0), m_nGeneration(0), m_bStop(false) {
+#ifdef LAZYVECTOR_HAS_AFFINITY
+    // hardware_concurrency counts every online CPU; taskset and cpusets restrict the process further.
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                m_stlCpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+}
+
+// DefaultWorkerCount implementation
+inline unsigned WorkerPool::DefaultWorkerCount() const {
+    if (!m_stlCpus.empty()) {
+        return static_cast<unsigned>(m_stlCpus.size());
+    }
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Destructor implementation
+inline WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_bStop = true;
+    }
+    m_cvStart.notify_all();
+
+    for (size_t i = 0; i < m_stlThreads.size(); i++) {
+        m_stlThreads[i].join();
+    }
+}
+
+// Run implementation
+inline void WorkerPool::Run(unsigned workerCount, const std::function<void(unsigned)>& task) {
+    if (workerCount <= 1 || isWorkerThread()) {
+        for (unsigned worker = 0; worker < workerCount; worker++) {
+            task(worker);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run(m_runMutex);
+    growTo(workerCount);
+
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_pTask = &task;
+        m_nActive = workerCount;
+        m_nPending = workerCount;
+        m_stlErrors.assign(workerCount, std::exception_ptr());
+        m_nGeneration++;
+    }
+    m_cvStart.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+        m_cvDone.wait(lock, [this]() { return m_nPending == 0; });
+        m_pTask = nullptr;
+    }
+
+    for (size_t i = 0; i < m_stlErrors.size(); i++) {
+        if (m_stlErrors[i]) {
+            std::exception_ptr error = m_stlErrors[i];
+            m_stlErrors.clear();
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// ParallelFor implementation
+template <typename Function>
+void WorkerPool::ParallelFor(size_t count, Function function, unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = Instance().DefaultWorkerCount();
+    }
+
+    if (threadCount > count) {
+        threadCount = static_cast<unsigned>(count);
+    }
+
+    if (threadCount <= 1) {
+        for (size_t index = 0; index < count; index++) {
+            function(index);
+        }
+        return;
+    }
+
+    Instance().Run(threadCount, [&function, count, threadCount](unsigned worker) {
+        size_t begin = count * worker / threadCount;
+        size_t end = count * (worker + 1) / threadCount;
+
+        for (size_t index = begin; index < end; index++) {
+            function(index);
+        }
+    });
+}
+
+// Private: growTo implementation
+inline void WorkerPool::growTo(unsigned count) {
+    // Called with m_runMutex held, so no job is running and the generation is stable.
+    m_stlThreads.reserve(count);
+
+    while (m_stlThreads.size() < count) {
+        unsigned index = static_cast<unsigned>(m_stlThreads.size());
+        m_stlThreads.push_back(std::thread(&WorkerPool::workerLoop, this, index, m_nGeneration));
+    }
+}
+
+// Private: workerLoop implementation
+inline void WorkerPool::workerLoop(unsigned index, uint64_t generation) {
+    isWorkerThread() = true;
+    pinToCpu(index);
+
+    std::unique_lock<std::mutex> lock(m_stateMutex);
+    for (;;) {
+        m_cvStart.wait(lock, [this, generation]() { return m_bStop || m_nGeneration != generation; });
+        if (m_bStop) {
+            return;
+        }
+
+        generation = m_nGeneration;
+        if (index >= m_nActive) {
+            continue;
+        }
+
+        const std::function<void(unsigned)>* pTask = m_pTask;
+        lock.unlock();
+
+        // Each worker owns its own error slot, so no lock is needed to fill it.
+        try {
+            (*pTask)(index);
+        } catch (...) {
+            m_stlErrors[index] = std::current_exception();
+        }
+
+        lock.lock();
+        if (--m_nPending == 0) {
+            m_cvDone.notify_all();
+        }
+    }
+}
+
+// Private: pinToCpu implementation
+inline void WorkerPool::pinToCpu(unsigned index) {
+#ifdef LAZYVECTOR_HAS_AFFINITY
+    // Workers are mapped onto the CPUs the process was allowed to use when the pool was created, in order.
+    if (m_stlCpus.empty()) {
+        return;
+    }
+
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(m_stlCpus[index % m_stlCpus.size()], &pinned);
+    ::pthread_setaffinity_np(::pthread_self(), sizeof(pinned), &pinned);
+#else
+    (void)index;
+#endif
+}
+
+// Private: isWorkerThread implementation
+inline bool& WorkerPool::isWorkerThread() {
+    static thread_local bool isWorker = false;
+    return isWorker;
+}
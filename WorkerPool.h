@@ -0,0 +1,142 @@
+/**
+ * WorkerPool.h
+ *
+ * Header file for WorkerPool class, the persistent set of CPU-pinned worker
+ * threads that ChunkedVector and LazyVector run their parallel loops on.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * WorkerPool class.
+ *
+ * A process-wide pool of worker threads created on first use and kept for
+ * the lifetime of the program. On Linux, worker k is pinned to the k-th CPU
+ * the process may run on, so a given worker index always runs on the same
+ * CPU (and therefore the same NUMA node). Memory first touched by worker k
+ * stays local to the CPU that worker k later processes it on.
+ *
+ * Jobs are run one at a time; concurrent callers wait for each other. A job
+ * started from inside a worker runs serially on that worker, so nested
+ * parallel loops cannot deadlock the pool.
+ */
+class WorkerPool {
+public:
+    /**
+     * Returns the process-wide pool.
+     */
+    static WorkerPool& Instance();
+
+    /**
+     * Returns the number of workers used when no thread count is given: the
+     * number of CPUs in the process affinity mask on Linux (which honours
+     * taskset and cpusets), the hardware concurrency elsewhere.
+     */
+    unsigned DefaultWorkerCount() const;
+
+    /**
+     * Runs task(worker) for every worker in [0, workerCount) and waits for
+     * all of them.
+     *
+     * The pool grows to workerCount threads if needed. If a task throws,
+     * the first exception (by worker) is rethrown on the calling thread
+     * once every worker is done.
+     *
+     * Parameters:
+     *   workerCount - The number of workers to run the task on
+     *   task        - Callable invoked as task(worker) on worker number worker
+     *
+     * Throws:
+     *   std::system_error - If a missing worker thread cannot be started
+     */
+    void Run(unsigned workerCount, const std::function<void(unsigned)>& task);
+
+    /**
+     * Runs a function over the indices [0, count) on the pool.
+     *
+     * Indices are split into contiguous, equally sized ranges, one per worker;
+     * the partition depends only on count and the thread count, so a given
+     * index always lands on the same worker. A single index is processed on
+     * the calling thread.
+     *
+     * Every worker finishes before this returns. If function throws, the
+     * worker stops at that index and the first exception (by worker) is
+     * rethrown on the calling thread.
+     *
+     * Parameters:
+     *   count       - The number of indices to process
+     *   function    - Callable invoked as function(index) for every index
+     *   threadCount - The number of worker threads (0 selects DefaultWorkerCount)
+     */
+    template <typename Function>
+    static void ParallelFor(size_t count, Function function, unsigned threadCount = 0);
+
+    /**
+     * Destructor.
+     * Stops and joins every worker.
+     */
+    ~WorkerPool();
+
+private:
+    WorkerPool();
+    WorkerPool(const WorkerPool&);
+    WorkerPool& operator=(const WorkerPool&);
+
+    /**
+     * Starts workers until the pool holds count threads.
+     */
+    void growTo(unsigned count);
+
+    /**
+     * Body of worker number index: pins itself, then runs jobs until the
+     * pool is stopped.
+     *
+     * Parameters:
+     *   index      - The worker number
+     *   generation - The job generation current when the worker was started
+     */
+    void workerLoop(unsigned index, uint64_t generation);
+
+    /**
+     * Pins the calling thread to the CPU of worker number index.
+     * Does nothing on platforms without thread affinity.
+     */
+    void pinToCpu(unsigned index);
+
+    /**
+     * Returns whether the calling thread is a worker of the pool.
+     */
+    static bool& isWorkerThread();
+
+private:
+    std::vector<std::thread> m_stlThreads;          ///< The workers, by worker number
+    std::vector<int> m_stlCpus;                     ///< The CPUs the process may use, in order (Linux only)
+    std::vector<std::exception_ptr> m_stlErrors;    ///< The exception of every worker in the current job
+    const std::function<void(unsigned)>* m_pTask;   ///< The task of the current job
+    unsigned m_nActive;                             ///< The number of workers taking part in the current job
+    unsigned m_nPending;                            ///< The number of those workers still running
+    uint64_t m_nGeneration;                         ///< Incremented for every job
+    bool m_bStop;                                   ///< Set when the pool is destroyed
+
+    std::mutex m_runMutex;                          ///< Serializes jobs
+    std::mutex m_stateMutex;                        ///< Guards the job state above
+    std::condition_variable m_cvStart;              ///< Signals a new job or stop to the workers
+    std::condition_variable m_cvDone;               ///< Signals the end of a job to the caller
+};
+
+// Include the implementation file
+#include "WorkerPool.cc"
+
+#endif // WORKERPOOL_H
@@ -9,6 +9,7 @@
  */
 
 #include "LazyVector.h"
+#include "EvaluationPlan.h"
 
 /**
  * Main entry point of the program.
@@ -18,6 +19,7 @@
  * 2. Populating them with values
  * 3. Performing various lazy arithmetic operations (add, subtract, multiply, divide)
  * 4. Displaying both original and computed vectors
+ * 5. Compiling an expression into an EvaluationPlan and executing it
  * 
  * Returns:
  *   0 on successful execution
@@ -60,5 +62,18 @@ int main(int argc, char const *argv[])
     std::cout << "Divided: (Vec2 / Vec1) ";
     divided.PrintVector();
 
+    // Compile an expression once, then execute it against the vectors
+    typedef PlanExpression<int> Expr;
+    Expr a = Expr::Placeholder(0), b = Expr::Placeholder(1);
+    EvaluationPlan<int> plan(Select(a > Expr::Constant(2), (a + b) * a, b));
+
+    std::vector<LazyVector<int>*> inputs;
+    inputs.push_back(&intVector1);
+    inputs.push_back(&intVector2);
+    LazyVector<int> planned = plan.Execute(inputs);
+
+    std::cout << "Plan: (Vec1 > 2 ? (Vec1 + Vec2) * Vec1 : Vec2) ";
+    planned.PrintVector();
+
     return 0;
 }
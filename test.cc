@@ -0,0 +1,808 @@
+/**
+ * test.cc
+ *
+ * Test program for LazyVector and its companion classes.
+ * Every check compares the library against a straightforward serial
+ * reference computed in the test itself.
+ *
+ * author: github.com/Shailendra53
+ */
+
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include "EvaluationPlan.h"
+
+/// Chunked storage with small chunks, so that short vectors still span several chunks.
+typedef ChunkedVector<double, 1024> SmallChunks;
+
+/// The number of failed checks.
+static int g_nFailures = 0;
+
+/**
+ * Records a check, printing its description if it failed.
+ */
+static void check(bool condition, const char* description) {
+    if (!condition) {
+        std::printf("FAILED: %s\n", description);
+        g_nFailures++;
+    }
+}
+
+/**
+ * Returns whether two results match, allowing for rounding differences.
+ */
+static bool same(double lhs, double rhs) {
+    if (lhs == rhs || (std::isnan(lhs) && std::isnan(rhs))) {
+        return true;
+    }
+
+    return std::fabs(lhs - rhs) <= 1e-9 * std::max(std::fabs(lhs), std::fabs(rhs));
+}
+
+/**
+ * Returns whether a LazyVector holds the expected elements.
+ */
+template <typename T, typename Storage>
+static bool matches(LazyVector<T, Storage>& actual, const std::vector<double>& expected) {
+    if (actual.size() != expected.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        if (!same(static_cast<double>(actual[static_cast<int>(i)]), expected[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Creates a LazyVector holding values.
+ */
+template <typename T, typename Storage>
+static LazyVector<T, Storage> makeVector(const std::vector<double>& values) {
+    Storage storage;
+    storage.resize(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        storage[i] = static_cast<T>(values[i]);
+    }
+
+    return LazyVector<T, Storage>(std::move(storage));
+}
+
+/**
+ * Creates count pseudo-random values in [low, high).
+ */
+static std::vector<double> randomValues(size_t count, double low, double high, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution(low, high);
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; i++) {
+        values[i] = distribution(generator);
+    }
+
+    return values;
+}
+
+/**
+ * ChunkedVector and the WorkerPool: explicit thread counts (so the pool runs
+ * even on a single-CPU host), exceptions, nesting, growth across chunks,
+ * shrinking and copying.
+ */
+static void testChunkedVector() {
+    typedef ChunkedVector<int, 4> Tiny;
+
+    std::printf("ChunkedVector and WorkerPool\n");
+
+    const size_t counts[] = { 0, 1, 3, 4, 37 };
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        std::vector<std::atomic<int> > visits(counts[c]);
+        for (size_t i = 0; i < visits.size(); i++) {
+            visits[i] = 0;
+        }
+
+        Tiny::ParallelForChunks(counts[c], [&](size_t chunk) { visits[chunk]++; }, 4);
+
+        bool once = true;
+        for (size_t i = 0; i < visits.size(); i++) {
+            once = once && visits[i] == 1;
+        }
+        check(once, "ParallelForChunks visits every chunk exactly once");
+    }
+
+    bool thrown = false;
+    try {
+        Tiny::ParallelForChunks(16, [](size_t chunk) {
+            if (chunk == 9) {
+                throw std::runtime_error("chunk failed");
+            }
+        }, 4);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "ParallelForChunks rethrows a worker exception");
+
+    std::atomic<int> nested(0);
+    Tiny::ParallelForChunks(8, [&](size_t) {
+        Tiny::ParallelForChunks(8, [&](size_t) { nested++; }, 4);
+    }, 4);
+    check(nested == 64, "nested ParallelForChunks runs every chunk");
+
+    Tiny grown;
+    for (int i = 0; i < 10; i++) {
+        grown.push_back(i);
+    }
+    bool pushed = grown.size() == 10 && grown.ChunkCount() == 3 && grown.ChunkLength(2) == 2;
+    for (int i = 0; i < 10; i++) {
+        pushed = pushed && grown[i] == i;
+    }
+    check(pushed, "push_back across chunk boundaries");
+
+    bool aligned = true;
+    for (size_t chunk = 0; chunk < grown.ChunkCount(); chunk++) {
+        aligned = aligned && reinterpret_cast<uintptr_t>(grown.ChunkData(chunk)) % 64 == 0;
+    }
+    check(aligned, "chunks are aligned");
+
+    Tiny copy(grown);
+    copy[0] = 100;
+    check(copy.size() == 10 && copy[9] == 9 && grown[0] == 0, "copy is deep");
+
+    Tiny assigned;
+    assigned = copy;
+    check(assigned.size() == 10 && assigned[0] == 100 && assigned[9] == 9, "assignment");
+
+    grown.resize(3);
+    grown.resize(10);
+    bool zeroed = grown.size() == 10 && grown[2] == 2;
+    for (int i = 3; i < 10; i++) {
+        zeroed = zeroed && grown[i] == 0;
+    }
+    check(zeroed, "shrink then grow resets the dropped elements");
+
+    int sum = 0;
+    for (Tiny::const_iterator it = copy.begin(); it != copy.end(); ++it) {
+        sum += *it;
+    }
+    check(sum == 145, "iteration over chunks");
+}
+
+/**
+ * A random plan expression together with its reference result.
+ */
+struct RandomExpression {
+    PlanExpression<double> expression;
+    std::vector<double> values;
+};
+
+/**
+ * Builds a random arithmetic expression over the inputs. Previously built
+ * subtrees are reused at random, so the plans contain shared subexpressions
+ * and operands such as x * x. With withMasks, constants, comparisons and
+ * Select are mixed in as well.
+ */
+static RandomExpression randomExpression(const std::vector<std::vector<double> >& inputs, int depth, bool withMasks,
+                                         std::vector<RandomExpression>& built, std::mt19937& generator) {
+    typedef PlanExpression<double> Expr;
+
+    int choice = static_cast<int>(generator() % 16);
+    RandomExpression result;
+
+    if (!built.empty() && choice == 0) {
+        return built[generator() % built.size()];
+    }
+
+    if (depth == 0 || choice < 3) {
+        if (withMasks && choice == 1) {
+            double value = static_cast<double>(generator() % 5) + 0.5;
+            result.expression = Expr::Constant(value);
+            result.values.assign(inputs[0].size(), value);
+        } else {
+            size_t index = generator() % inputs.size();
+            result.expression = Expr::Placeholder(index);
+            result.values = inputs[index];
+        }
+        return result;
+    }
+
+    RandomExpression lhs = randomExpression(inputs, depth - 1, withMasks, built, generator);
+    RandomExpression rhs = randomExpression(inputs, depth - 1, withMasks, built, generator);
+    size_t count = inputs[0].size();
+    result.values.resize(count);
+
+    switch (choice % (withMasks ? 8 : 4)) {
+    case 0 :
+        result.expression = lhs.expression + rhs.expression;
+        for (size_t i = 0; i < count; i++) result.values[i] = lhs.values[i] + rhs.values[i];
+        break;
+    case 1 :
+        result.expression = lhs.expression - rhs.expression;
+        for (size_t i = 0; i < count; i++) result.values[i] = lhs.values[i] - rhs.values[i];
+        break;
+    case 2 :
+        result.expression = lhs.expression * rhs.expression;
+        for (size_t i = 0; i < count; i++) result.values[i] = lhs.values[i] * rhs.values[i];
+        break;
+    case 3 :
+        result.expression = lhs.expression / rhs.expression;
+        for (size_t i = 0; i < count; i++) result.values[i] = lhs.values[i] / rhs.values[i];
+        break;
+    case 4 :
+        result.expression = lhs.expression > rhs.expression;
+        for (size_t i = 0; i < count; i++) result.values[i] = lhs.values[i] > rhs.values[i];
+        break;
+    case 5 :
+        result.expression = lhs.expression <= rhs.expression;
+        for (size_t i = 0; i < count; i++) result.values[i] = lhs.values[i] <= rhs.values[i];
+        break;
+    default : {
+        RandomExpression mask = randomExpression(inputs, depth - 1, withMasks, built, generator);
+        Expr selector = mask.expression > Expr::Constant(1.5);
+        result.expression = Select(selector, lhs.expression, rhs.expression);
+        for (size_t i = 0; i < count; i++) result.values[i] = mask.values[i] > 1.5 ? lhs.values[i] : rhs.values[i];
+        break;
+    }
+    }
+
+    built.push_back(result);
+    return result;
+}
+
+/**
+ * Random input vectors in [1, 2) for evaluation plans, with their reference
+ * values and the pointers bound to the placeholders.
+ */
+template <typename Storage>
+struct PlanInputs {
+    std::vector<std::vector<double> > values;
+    std::vector<LazyVector<double, Storage> > vectors;
+    std::vector<LazyVector<double, Storage>*> bound;
+
+    PlanInputs(size_t inputCount, size_t count, std::mt19937& generator) {
+        for (size_t i = 0; i < inputCount; i++) {
+            values.push_back(randomValues(count, 1.0, 2.0, generator));
+            vectors.push_back(makeVector<double, Storage>(values.back()));
+        }
+
+        for (size_t i = 0; i < inputCount; i++) {
+            bound.push_back(&vectors[i]);
+        }
+    }
+};
+
+/**
+ * Evaluation plans: shared subexpressions, repeated operands, small blocks
+ * and chunked storage, then random expressions checked against their
+ * reference.
+ */
+template <typename Storage>
+static void testEvaluationPlans(const char* storageName) {
+    typedef PlanExpression<double> Expr;
+    typedef LazyVector<double, Storage> Vector;
+
+    std::printf("Evaluation plans (%s)\n", storageName);
+
+    std::mt19937 generator(2718);
+    const size_t count = 5000;
+    PlanInputs<Storage> inputs(3, count, generator);
+
+    const std::vector<double>& x = inputs.values[0];
+    const std::vector<double>& y = inputs.values[1];
+    const std::vector<double>& z = inputs.values[2];
+    Expr a = Expr::Placeholder(0), b = Expr::Placeholder(1), c = Expr::Placeholder(2);
+    std::vector<double> expected(count);
+
+    // A shared subexpression is computed once and read by several users.
+    Expr shared = a + b;
+    EvaluationPlan<double, Storage> sharedPlan((shared * shared) - shared / c, 7);
+    Vector sharedResult = sharedPlan.Execute(inputs.bound);
+    for (size_t i = 0; i < count; i++) expected[i] = (x[i] + y[i]) * (x[i] + y[i]) - (x[i] + y[i]) / z[i];
+    check(matches(sharedResult, expected), "shared subexpression");
+
+    EvaluationPlan<double, Storage> squarePlan(a * a);
+    Vector squareResult = squarePlan.Execute(inputs.bound);
+    for (size_t i = 0; i < count; i++) expected[i] = x[i] * x[i];
+    check(matches(squareResult, expected), "x * x");
+
+    EvaluationPlan<double, Storage> identityPlan(b);
+    Vector identityResult = identityPlan.Execute(inputs.bound);
+    check(matches(identityResult, y), "bare placeholder");
+
+    std::vector<std::vector<Vector*> > inputSets(3, inputs.bound);
+    std::vector<Vector> batch = sharedPlan.ExecuteBatch(inputSets);
+    check(batch.size() == 3 && matches(batch[2], sharedResult.GetVector()), "ExecuteBatch");
+
+    bool thrown = false;
+    try {
+        std::vector<Vector*> missing(1, inputs.bound[0]);
+        sharedPlan.Execute(missing);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown, "missing input is rejected");
+
+    int mismatches = 0;
+    for (int round = 0; round < 300; round++) {
+        std::vector<RandomExpression> built;
+        RandomExpression random = randomExpression(inputs.values, 5, false, built, generator);
+
+        EvaluationPlan<double, Storage> plan(random.expression, 1 + generator() % 300);
+        Vector result = plan.Execute(inputs.bound);
+        if (!matches(result, random.values)) {
+            mismatches++;
+        }
+    }
+    check(mismatches == 0, "random expressions match their reference");
+}
+
+/**
+ * Evaluation plans with constants, comparisons and Select, then random
+ * expressions mixing them with arithmetic.
+ */
+template <typename Storage>
+static void testPlanMasks(const char* storageName) {
+    typedef PlanExpression<double> Expr;
+    typedef LazyVector<double, Storage> Vector;
+
+    std::printf("Evaluation plan masks (%s)\n", storageName);
+
+    std::mt19937 generator(1618);
+    const size_t count = 5000;
+    PlanInputs<Storage> inputs(3, count, generator);
+
+    const std::vector<double>& x = inputs.values[0];
+    const std::vector<double>& y = inputs.values[1];
+    const std::vector<double>& z = inputs.values[2];
+    Expr a = Expr::Placeholder(0), b = Expr::Placeholder(1), c = Expr::Placeholder(2);
+    std::vector<double> expected(count);
+
+    EvaluationPlan<double, Storage> constantPlan(a * Expr::Constant(2) + Expr::Constant(1));
+    Vector constantResult = constantPlan.Execute(inputs.bound);
+    for (size_t i = 0; i < count; i++) expected[i] = x[i] * 2 + 1;
+    check(matches(constantResult, expected), "constants");
+
+    EvaluationPlan<double, Storage> selectPlan(Select(a > b, a - b, Expr::Constant(0)));
+    Vector selectResult = selectPlan.Execute(inputs.bound);
+    for (size_t i = 0; i < count; i++) expected[i] = x[i] > y[i] ? x[i] - y[i] : 0;
+    check(matches(selectResult, expected), "Select");
+
+    EvaluationPlan<double, Storage> maskPlan((a > b) * (b <= c) + (a == a));
+    Vector maskResult = maskPlan.Execute(inputs.bound);
+    for (size_t i = 0; i < count; i++) expected[i] = (x[i] > y[i]) * (y[i] <= z[i]) + 1;
+    check(matches(maskResult, expected), "combined masks");
+
+    int mismatches = 0;
+    for (int round = 0; round < 300; round++) {
+        std::vector<RandomExpression> built;
+        RandomExpression random = randomExpression(inputs.values, 5, true, built, generator);
+
+        // Bare constants cannot be compiled on their own.
+        bool usesInput = false;
+        try {
+            EvaluationPlan<double, Storage> plan(random.expression, 1 + generator() % 300);
+            usesInput = true;
+            Vector result = plan.Execute(inputs.bound);
+            if (!matches(result, random.values)) {
+                mismatches++;
+            }
+        } catch (const std::invalid_argument&) {
+            if (usesInput) {
+                mismatches++;
+            }
+        }
+    }
+    check(mismatches == 0, "random mask expressions match their reference");
+}
+
+/**
+ * Comparisons and MaskedAssign, including the pending state they leave
+ * behind on their operands.
+ */
+template <typename Storage>
+static void testMasks(const char* storageName) {
+    typedef LazyVector<double, Storage> Vector;
+
+    std::printf("Masks (%s)\n", storageName);
+
+    std::mt19937 generator(1732);
+    std::vector<double> x = randomValues(5000, 0.0, 1.0, generator);
+    std::vector<double> y = randomValues(5000, 0.0, 1.0, generator);
+    std::vector<double> expected(x.size());
+    Vector a = makeVector<double, Storage>(x);
+    Vector b = makeVector<double, Storage>(y);
+
+    Vector mask = (a > b);
+    for (size_t i = 0; i < x.size(); i++) expected[i] = x[i] > y[i];
+    check(matches(mask, expected), "comparison mask");
+
+    a.MaskedAssign(mask, b);
+    for (size_t i = 0; i < x.size(); i++) expected[i] = x[i] > y[i] ? y[i] : x[i];
+    check(matches(a, expected), "MaskedAssign");
+
+    // The comparison left a pending operation on a; copying must not replay it.
+    Vector copy(a);
+    check(matches(copy, expected), "copy after MaskedAssign");
+
+    // The pending operations these operators leave on mask and b describe their results, not mask and b.
+    Vector target = makeVector<double, Storage>(x);
+    Vector scaled = (mask * b);
+    Vector sum = (b + mask);
+    target.MaskedAssign(mask, b);
+    check(matches(target, expected), "MaskedAssign reads the stored elements of pending operands");
+}
+
+/**
+ * Scans and rolling windows over vectors spanning many segments, with
+ * windows smaller and larger than a segment and than the vector.
+ */
+template <typename Storage>
+static void testScansAndWindows(const char* storageName) {
+    typedef LazyVector<double, Storage> Vector;
+
+    std::printf("Scans and rolling windows (%s)\n", storageName);
+
+    // Small integers keep every sum exact, whatever the evaluation order.
+    std::mt19937 generator(1618);
+    const size_t count = 200000;
+    std::vector<double> x(count);
+    for (size_t i = 0; i < count; i++) {
+        x[i] = static_cast<double>(static_cast<int>(generator() % 101) - 50);
+    }
+    Vector source = makeVector<double, Storage>(x);
+    std::vector<double> expected(count);
+
+    Vector sum = source.CumSum();
+    double running = 0;
+    for (size_t i = 0; i < count; i++) expected[i] = running += x[i];
+    check(matches(sum, expected), "CumSum");
+
+    Vector peak = source.Scan([](double a, double b) { return std::max(a, b); });
+    running = x[0];
+    for (size_t i = 0; i < count; i++) expected[i] = running = std::max(running, x[i]);
+    check(matches(peak, expected), "Scan with maximum");
+
+    std::vector<double> factors(count, 1.0);
+    factors[10] = 2.0;
+    factors[150000] = 3.0;
+    Vector ones = makeVector<double, Storage>(factors);
+    Vector product = ones.CumProd();
+    for (size_t i = 0; i < count; i++) expected[i] = i < 10 ? 1 : (i < 150000 ? 2 : 6);
+    check(matches(product, expected), "CumProd");
+
+    bool thrown = false;
+    try {
+        Vector failed = source.Scan([](double a, double b) -> double {
+            if (a > 1000) {
+                throw std::runtime_error("scan failed");
+            }
+            return a + std::fabs(b);
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "exception thrown by a Scan operation reaches the caller");
+
+    const size_t windows[] = { 1, 3, 1000, 65536, 100001, 300000 };
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        size_t window = windows[w];
+        std::vector<double> sums(count), means(count), minimums(count), maximums(count);
+
+        double total = 0;
+        for (size_t i = 0; i < count; i++) {
+            total += x[i];
+            if (i >= window) {
+                total -= x[i - window];
+            }
+            sums[i] = total;
+            means[i] = total / static_cast<double>(std::min(i + 1, window));
+        }
+
+        // Reference extremes: a plain scan of the window for the first elements and a sample of the others.
+        Vector minimum = source.RollingMin(window);
+        Vector maximum = source.RollingMax(window);
+        bool extremesMatch = true;
+        for (size_t i = 0; i < count; i += (i < 2000 ? 1 : 997)) {
+            size_t first = i + 1 >= window ? i + 1 - window : 0;
+            double low = x[first], high = x[first];
+            for (size_t j = first; j <= i; j++) {
+                low = std::min(low, x[j]);
+                high = std::max(high, x[j]);
+            }
+            extremesMatch = extremesMatch && minimum[static_cast<int>(i)] == low &&
+                            maximum[static_cast<int>(i)] == high;
+        }
+
+        Vector rollingSum = source.RollingSum(window);
+        Vector rollingMean = source.RollingMean(window);
+        check(matches(rollingSum, sums), "RollingSum");
+        check(matches(rollingMean, means), "RollingMean");
+        check(extremesMatch, "RollingMin and RollingMax");
+    }
+
+    // One huge element must not swallow the small ones once it has left the window.
+    std::vector<double> mixed(150000, 1.0);
+    mixed[0] = 1e16;
+    mixed[70000] = -3e15;
+    Vector mixedSource = makeVector<double, Storage>(mixed);
+    Vector mixedSum = mixedSource.RollingSum(2);
+    Vector mixedMean = mixedSource.RollingMean(2);
+    bool mixedMatches = true;
+    for (size_t i = 0; i < mixed.size(); i++) {
+        double expectedSum = i == 0 ? mixed[0] : mixed[i - 1] + mixed[i];
+        mixedMatches = mixedMatches && mixedSum[static_cast<int>(i)] == expectedSum &&
+                       mixedMean[static_cast<int>(i)] == expectedSum / (i == 0 ? 1 : 2);
+    }
+    check(mixedMatches, "RollingSum and RollingMean of mixed magnitudes");
+
+    thrown = false;
+    try {
+        source.RollingSum(0);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown, "zero window is rejected");
+
+    // A pending scan stores no other vector, but still blocks changing the vector it will be replayed on.
+    const char* textPath = "lazy_vector_scan_test.txt";
+    const char* binaryPath = "lazy_vector_scan_test.lzv";
+    std::vector<double> three(3);
+    three[0] = 1; three[1] = 2; three[2] = 3;
+    Vector pending = makeVector<double, Storage>(three);
+    pending.SaveText(textPath);
+    pending.SaveBinary(binaryPath);
+
+    Vector pendingSum = pending.CumSum();
+    thrown = false;
+    try {
+        pending.PushValue(4);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown && pending.size() == 3, "PushValue rejects a vector with a pending scan");
+
+    Vector pendingProduct = pending.CumProd();
+    thrown = false;
+    try {
+        pending.LoadText(textPath);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown, "LoadText rejects a vector with a pending scan");
+
+    Vector pendingWindow = pending.RollingSum(2);
+    thrown = false;
+    try {
+        pending.LoadBinary(binaryPath);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown, "LoadBinary rejects a vector with a pending rolling window");
+
+    std::remove(textPath);
+    std::remove(binaryPath);
+}
+
+/**
+ * Checks data() and View() of a vector holding expected. Only contiguous
+ * storage has them; the overload below skips every other storage.
+ */
+static void checkContiguousViews(LazyVector<double>& vector, const std::vector<double>& expected) {
+    double* pData = vector.data();
+    VectorView<double> view = vector.View();
+    check(view.data() == pData && view.size() == expected.size(), "View covers data()");
+    check(std::equal(view.begin(), view.end(), expected.begin()), "View holds the elements");
+
+    pData[1] = -1.0;
+    check(vector[1] == -1.0, "writes through data() reach the vector");
+    pData[1] = expected[1];
+}
+
+template <typename Storage>
+static void checkContiguousViews(LazyVector<double, Storage>&, const std::vector<double>&) {}
+
+/**
+ * Zero-copy access: data(), View(), ChunkView(), iterators, and handing the
+ * storage out with Release and back with the adopting constructor.
+ */
+template <typename Storage>
+static void testViews(const char* storageName) {
+    typedef LazyVector<double, Storage> Vector;
+
+    std::printf("Views (%s)\n", storageName);
+
+    std::mt19937 generator(1123);
+    std::vector<double> values = randomValues(5000, -1.0, 1.0, generator);
+    Vector vector = makeVector<double, Storage>(values);
+
+    checkContiguousViews(vector, values);
+
+    std::vector<double> chunked;
+    for (size_t chunk = 0; chunk < vector.ChunkCount(); chunk++) {
+        VectorView<double> view = vector.ChunkView(chunk);
+        chunked.insert(chunked.end(), view.begin(), view.end());
+    }
+    check(chunked == values, "ChunkViews cover the elements in order");
+
+    VectorView<double> last = vector.ChunkView(vector.ChunkCount() - 1);
+    int lastStart = static_cast<int>(values.size() - last.size());
+    last[0] = 7.0;
+    check(vector[lastStart] == 7.0, "writes through ChunkView reach the vector");
+    last[0] = values[lastStart];
+
+    check(static_cast<size_t>(vector.end() - vector.begin()) == values.size(), "end() - begin() is the size");
+    check(std::equal(vector.begin(), vector.end(), values.begin()), "iterators visit the elements in order");
+    check(2 + vector.begin() == vector.begin() + 2 && *(2 + vector.begin()) == values[2], "n + iterator");
+
+    // The pending operation left by the operator is discarded, not replayed after adoption.
+    Vector other = makeVector<double, Storage>(values);
+    Vector sum = (vector + other);
+    const double* pFirst = vector.ChunkView(0).data();
+    Storage storage = vector.Release();
+    check(vector.size() == 0, "Release leaves the vector empty");
+
+    Vector adopted(std::move(storage));
+    check(adopted.ChunkView(0).data() == pFirst, "Release and adoption do not copy");
+    Vector copy(adopted);
+    check(matches(copy, values), "Release and adoption round trip");
+}
+
+/**
+ * Writes text to a file.
+ */
+static void writeFile(const char* path, const char* text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+/**
+ * Returns whether loading a text file holding text into LazyVector<T> is rejected.
+ */
+template <typename T>
+static bool textRejected(const char* path, const char* text) {
+    writeFile(path, text);
+
+    LazyVector<T> vector;
+    try {
+        vector.LoadText(path);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * File I/O: binary and text round trips, memory mapping, and rejection of
+ * corrupted or out-of-range input.
+ */
+template <typename Storage>
+static void testFileIO(const char* storageName) {
+    typedef LazyVector<double, Storage> Vector;
+
+    std::printf("File I/O (%s)\n", storageName);
+
+    const char* binaryPath = "lazy_vector_test.lzv";
+    const char* textPath = "lazy_vector_test.txt";
+
+    std::mt19937 generator(1414);
+    std::vector<double> values = randomValues(3000, -1e6, 1e6, generator);
+    values[0] = 0.1;
+    values[1] = -0.0;
+    values[2] = 1e-300;
+    values[3] = 1e-310;
+    values[4] = 5e-324;
+    values[5] = -2.5e-320;
+    Vector source = makeVector<double, Storage>(values);
+
+    source.SaveBinary(binaryPath);
+    Vector binary;
+    binary.LoadBinary(binaryPath);
+    check(matches(binary, values), "binary round trip");
+
+    MappedVector<double> mapped(binaryPath);
+    bool mappedMatches = mapped.size() == values.size();
+    for (size_t i = 0; mappedMatches && i < values.size(); i++) {
+        mappedMatches = mapped[i] == values[i];
+    }
+    check(mappedMatches, "MappedVector reads the saved elements");
+
+    // The text format keeps enough digits to read every value back exactly.
+    source.SaveText(textPath);
+    Vector text;
+    text.LoadText(textPath);
+    bool textMatches = text.size() == values.size();
+    for (size_t i = 0; textMatches && i < values.size(); i++) {
+        textMatches = text[static_cast<int>(i)] == values[i];
+    }
+    check(textMatches, "text round trip is exact");
+
+    Vector empty;
+    empty.SaveBinary(binaryPath);
+    binary.LoadBinary(binaryPath);
+    check(binary.size() == 0, "empty binary round trip");
+
+    bool thrown = false;
+    try {
+        LazyVector<float> other;
+        other.LoadBinary(binaryPath);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown, "binary file of another element type is rejected");
+
+    // A length larger than the file must be rejected before anything is allocated.
+    source.SaveBinary(binaryPath);
+    {
+        std::fstream file(binaryPath, std::ios::in | std::ios::out | std::ios::binary);
+        VectorFileHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.nLength = static_cast<uint64_t>(1) << 36;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    thrown = false;
+    try {
+        binary.LoadBinary(binaryPath);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown, "binary file shorter than its header is rejected");
+
+    thrown = false;
+    try {
+        MappedVector<double> truncated(binaryPath);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown, "MappedVector rejects a binary file shorter than its header");
+
+    check(textRejected<int>(textPath, "1 99999999999 3"), "int text out of range is rejected");
+    check(textRejected<unsigned>(textPath, "-1"), "negative unsigned text is rejected");
+    check(textRejected<short>(textPath, "40000"), "short text out of range is rejected");
+    check(textRejected<double>(textPath, "1 2x 3"), "malformed text is rejected");
+    check(!textRejected<int>(textPath, "-2147483648 2147483647\n"), "int text at the limits is accepted");
+    check(!textRejected<float>(textPath, "1e-40 -1.4e-45\n"), "subnormal float text is accepted");
+    check(!textRejected<double>(textPath, "1e-310 4.9406564584124654e-324\n"), "subnormal double text is accepted");
+    check(textRejected<float>(textPath, "1e40"), "float text that overflows is rejected");
+    check(textRejected<double>(textPath, "1e-400"), "double text that underflows to zero is rejected");
+
+    std::remove(binaryPath);
+    std::remove(textPath);
+}
+
+/**
+ * Main entry point of the test program.
+ *
+ * Returns:
+ *   0 if every check passed, 1 otherwise
+ */
+int main(int argc, char const *argv[])
+{
+    testChunkedVector();
+    testEvaluationPlans<std::vector<double> >("std::vector");
+    testEvaluationPlans<SmallChunks>("ChunkedVector");
+    testPlanMasks<std::vector<double> >("std::vector");
+    testPlanMasks<SmallChunks>("ChunkedVector");
+    testMasks<std::vector<double> >("std::vector");
+    testMasks<SmallChunks>("ChunkedVector");
+    testScansAndWindows<std::vector<double> >("std::vector");
+    testScansAndWindows<SmallChunks>("ChunkedVector");
+    testViews<std::vector<double> >("std::vector");
+    testViews<SmallChunks>("ChunkedVector");
+    testFileIO<std::vector<double> >("std::vector");
+    testFileIO<SmallChunks>("ChunkedVector");
+
+    if (g_nFailures != 0) {
+        std::printf("%d check(s) failed\n", g_nFailures);
+        return 1;
+    }
+
+    std::printf("All checks passed\n");
+    return 0;
+}